@@ -0,0 +1,147 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Burst.hpp"
+
+#include <Arduino.h>
+
+void Burst::add(Print *output, const Code &code) {
+	if (code.isLong()) {
+		if (repeats > 0) {
+			finish(output);
+		}
+		return;
+	}
+
+	if (repeats > 0) {
+		if (code.messageLength != this->code.messageLength
+				|| (code.endTime - code.duration) - this->code.endTime > MAX_GAP_US
+				|| differentBits(code) * MAX_DIFFERENT_BITS_DIVISOR > code.messageLength) {
+			finish(output);
+		}
+	}
+
+	if (repeats == 0) {
+		for (unsigned int plane = 0; plane < 3; plane++) {
+			memset(votes[plane], 0, (code.messageLength + 7) >> 3);
+		}
+	}
+
+	if (repeats < MAX_VOTES) {
+		for (unsigned int i = 0; i < ((code.messageLength + 7) >> 3); i++) {
+			uint8_t carry = code.message[i];
+
+			for (unsigned int plane = 0; plane < 3; plane++) {
+				uint8_t next = votes[plane][i] & carry;
+
+				votes[plane][i] ^= carry;
+				carry = next;
+			}
+		}
+
+		repeats++;
+	}
+
+	this->code = code;
+}
+
+void Burst::expire(Print *output, unsigned long now) {
+	if (repeats > 0 && now - code.endTime > TIMEOUT_US) {
+		finish(output);
+	}
+}
+
+void Burst::flush(Print *output) {
+	if (repeats > 0) {
+		finish(output);
+	}
+}
+
+// Number of 1-bit votes for a bit
+uint8_t Burst::ones(unsigned int bit) const {
+	const uint8_t mask = 0x80 >> (bit & 0x07);
+	uint8_t ones = 0;
+
+	for (unsigned int plane = 0; plane < 3; plane++) {
+		if (votes[plane][bit / 8] & mask) {
+			ones |= 1 << plane;
+		}
+	}
+
+	return ones;
+}
+
+// Value of a bit in the combined code
+bool Burst::majority(unsigned int bit) const {
+	const uint8_t count = ones(bit);
+
+	if (count * 2 == repeats) {
+		// Ties use the most recent repeat, but are output as unresolved
+		return code.message[bit / 8] & (0x80 >> (bit & 0x07));
+	}
+
+	return count * 2 > repeats;
+}
+
+// Number of bits in a code of the same length that are different from the
+// combined code
+unsigned int Burst::differentBits(const Code &code) const {
+	unsigned int count = 0;
+
+	for (unsigned int i = 0; i < code.messageLength; i++) {
+		if (majority(i) != (bool)(code.message[i / 8] & (0x80 >> (i & 0x07)))) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+void Burst::finish(Print *output) {
+	if (repeats >= MIN_REPEATS) {
+		unsigned long agree = 0;
+		uint16_t unresolved = 0;
+
+		for (unsigned int i = 0; i < code.messageLength; i++) {
+			const uint8_t mask = 0x80 >> (i & 0x07);
+			const uint8_t count = ones(i);
+
+			if (majority(i)) {
+				code.message[i / 8] |= mask;
+			} else {
+				code.message[i / 8] &= ~mask;
+			}
+
+			if (count * 2 == repeats) {
+				unresolved++;
+			}
+
+			agree += (count * 2 > repeats) ? count : (repeats - count);
+		}
+
+		code.repeats = repeats;
+		code.unresolved = unresolved;
+		// Percentage of votes that agree with the combined code
+		code.confidence = code.messageLength ? (agree * 100 / (code.messageLength * repeats)) : 0;
+
+		output->print("burst: ");
+		output->println(code);
+	}
+
+	repeats = 0;
+}
@@ -0,0 +1,68 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RF433_OOK_BURST_HPP
+#define RF433_OOK_BURST_HPP
+
+#include <Arduino.h>
+
+#include "Code.hpp"
+
+// Combines the repeats of a code that are received in a burst, using a
+// majority vote for each bit so that a corrupted repeat can be corrected
+class Burst {
+public:
+	// Add a code that has been output, which ends the current burst
+	// (outputting the combined code) if it's not a repeat (long codes
+	// are not combined because their overflow buffer isn't kept)
+	void add(Print *output, const Code &code);
+
+	// Output the combined code if the burst has ended
+	void expire(Print *output, unsigned long now);
+	// Output the combined code without waiting for the burst to end
+	void flush(Print *output);
+
+	// Maximum time between the end of a code and the start of the next
+	// repeat (allowing for a missing repeat)
+	static constexpr unsigned long MAX_GAP_US = 50000;
+	// Time after the end of the last code before the burst is output
+	static constexpr unsigned long TIMEOUT_US = 250000;
+
+	// Minimum number of repeats to output
+	static constexpr uint8_t MIN_REPEATS = 2;
+	// Maximum number of repeats that are counted
+	static constexpr uint8_t MAX_VOTES = (1 << 3) - 1;
+	// Maximum proportion of the bits (1 in this many) that can be
+	// different from the combined code for a code to be a repeat (the
+	// commands of HomeEasy codes can differ by only 2 bits, but those
+	// are not sent within MAX_GAP_US of each other)
+	static constexpr unsigned int MAX_DIFFERENT_BITS_DIVISOR = 16;
+
+private:
+	uint8_t ones(unsigned int bit) const;
+	bool majority(unsigned int bit) const;
+	unsigned int differentBits(const Code &code) const;
+	void finish(Print *output);
+
+	Code code; // Most recent repeat
+	uint8_t repeats = 0;
+	// Number of 1-bit votes for each bit, as a 3-bit count in bit planes
+	uint8_t votes[3][Code::INLINE_SIZE];
+};
+
+#endif
@@ -0,0 +1,92 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Checksum.hpp"
+
+#include <Arduino.h>
+
+// Polynomial 0x31 (used by LaCrosse and Fine Offset sensors)
+static const uint8_t crc8_31[16] = {
+	0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97,
+	0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E,
+};
+
+// Polynomial 0x07 (CRC-8/SMBUS)
+static const uint8_t crc8_07[16] = {
+	0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15,
+	0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D,
+};
+
+static const CRC8Checksum crc8("crc8-31", crc8_31, 0x00);
+static const CRC8Checksum crc8smbus("crc8-07", crc8_07, 0x00);
+static const SumChecksum sum8;
+static const XorChecksum xor8;
+
+const Checksum *const Checksum::ALL[] = { &crc8, &crc8smbus, &sum8, &xor8 };
+const unsigned int Checksum::COUNT = sizeof(ALL) / sizeof(ALL[0]);
+
+bool Checksum::verify(const Code::Message &data, unsigned int length) const {
+	uint8_t zero = 0;
+
+	if (length < 2) {
+		return false;
+	}
+
+	for (unsigned int i = 0; i < length; i++) {
+		zero |= data[i];
+	}
+
+	// Every checksum of all zeros is zero
+	if (!zero) {
+		return false;
+	}
+
+	return calculate(data, length - 1) == data[length - 1];
+}
+
+uint8_t CRC8Checksum::calculate(const Code::Message &data, unsigned int length) const {
+	uint8_t crc = init_;
+
+	for (unsigned int i = 0; i < length; i++) {
+		crc ^= data[i];
+		crc = (uint8_t)(crc << 4) ^ table_[crc >> 4];
+		crc = (uint8_t)(crc << 4) ^ table_[crc >> 4];
+	}
+
+	return crc;
+}
+
+uint8_t SumChecksum::calculate(const Code::Message &data, unsigned int length) const {
+	uint8_t sum = 0;
+
+	for (unsigned int i = 0; i < length; i++) {
+		sum += data[i];
+	}
+
+	return sum;
+}
+
+uint8_t XorChecksum::calculate(const Code::Message &data, unsigned int length) const {
+	uint8_t value = 0;
+
+	for (unsigned int i = 0; i < length; i++) {
+		value ^= data[i];
+	}
+
+	return value;
+}
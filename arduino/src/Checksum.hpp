@@ -0,0 +1,70 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RF433_OOK_CHECKSUM_HPP
+#define RF433_OOK_CHECKSUM_HPP
+
+#include <Arduino.h>
+
+#include "Code.hpp"
+
+// Check value in the last byte of a message, calculated over
+// all of the previous bytes
+class Checksum {
+public:
+	virtual ~Checksum() {}
+	virtual const char *name() const = 0;
+	virtual uint8_t calculate(const Code::Message &data, unsigned int length) const = 0;
+
+	// Returns true if the last byte is the check value of the other bytes
+	bool verify(const Code::Message &data, unsigned int length) const;
+
+	// All of the checksums that demodulated messages are checked against
+	static const Checksum *const ALL[];
+	static const unsigned int COUNT;
+};
+
+// CRC-8 (most significant bit first) using a table for each nibble
+class CRC8Checksum: public Checksum {
+public:
+	constexpr CRC8Checksum(const char *name, const uint8_t *table, uint8_t init)
+		: name_(name), table_(table), init_(init) {}
+	const char *name() const override { return name_; }
+	uint8_t calculate(const Code::Message &data, unsigned int length) const override;
+
+private:
+	const char *name_;
+	const uint8_t *table_; // CRC of each value in the top nibble
+	const uint8_t init_;
+};
+
+// Sum of the bytes (modulo 256)
+class SumChecksum: public Checksum {
+public:
+	const char *name() const override { return "sum8"; }
+	uint8_t calculate(const Code::Message &data, unsigned int length) const override;
+};
+
+// Exclusive or of the bytes
+class XorChecksum: public Checksum {
+public:
+	const char *name() const override { return "xor8"; }
+	uint8_t calculate(const Code::Message &data, unsigned int length) const override;
+};
+
+#endif
@@ -0,0 +1,30 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Clock.hpp"
+
+#include <Arduino.h>
+
+unsigned long Clock::last = 0;
+uint32_t Clock::wraps = 0;
+
+void Clock::update() {
+	noInterrupts();
+	extend(micros());
+	interrupts();
+}
@@ -0,0 +1,50 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RF433_OOK_CLOCK_HPP
+#define RF433_OOK_CLOCK_HPP
+
+#include <Arduino.h>
+
+// Extends micros() to 64 bits so that times don't wrap (every ~71 minutes
+// on boards with a 32-bit clock), this needs to be updated more often than
+// that from the core that handles receiver interrupts
+class Clock {
+public:
+	// Interrupts must be disabled
+	static inline uint64_t extend(unsigned long now) {
+		if (sizeof(now) >= sizeof(uint64_t)) {
+			return now;
+		}
+
+		if (now < last) {
+			wraps++;
+		}
+		last = now;
+
+		return ((uint64_t)wraps << 32) | now;
+	}
+
+	static void update();
+
+private:
+	static unsigned long last;
+	static uint32_t wraps;
+};
+
+#endif
@@ -20,52 +20,105 @@
  */
 
 #include "Code.hpp"
+#include "Checksum.hpp"
+#include "LineCoding.hpp"
 #include "Receiver.hpp"
 #include "Transmitter.hpp"
 #include "Main.hpp"
 
 Code::Code() {
 	valid = false;
+	repeats = 0;
+	unresolved = 0;
+	messageLength = 0;
+}
+
+Code::Code(const Code &code) : Printable() {
+	*this = code;
 }
 
 Code::~Code() {
 
 }
 
-Code::Code(const char *message) {
+// Codes are copied with interrupts disabled, so only
+// copy the part of the message that's used
+Code &Code::operator=(const Code &code) {
+	const unsigned int length = (code.messageLength + 7) / 8;
+
+	if (this == &code) {
+		return *this;
+	}
+
+	if (overflow != nullptr) {
+		if (length > INLINE_SIZE) {
+			memcpy(overflow, code.message.overflow, length - INLINE_SIZE);
+		}
+		message.overflow = overflow;
+	} else {
+		message.overflow = code.message.overflow;
+	}
+	memcpy(message.bytes, code.message.bytes, length < INLINE_SIZE ? length : INLINE_SIZE);
+	messageLength = code.messageLength;
+	duration = code.duration;
+	endTime = code.endTime;
+	startTimestamp = code.startTimestamp;
+	endTimestamp = code.endTimestamp;
+	prePauseTime = code.prePauseTime;
+	postPauseTime = code.postPauseTime;
+	preambleTime[0] = code.preambleTime[0];
+	preambleTime[1] = code.preambleTime[1];
+	bitTotalTime[0] = code.bitTotalTime[0];
+	bitTotalTime[1] = code.bitTotalTime[1];
+	noiseRate = code.noiseRate;
+	glitches = code.glitches;
+	repeats = code.repeats;
+	confidence = code.confidence;
+	unresolved = code.unresolved;
+	prePauseStandalone = code.prePauseStandalone;
+	postPausePresent = code.postPausePresent;
+	valid = code.valid;
+#ifdef TRACE_BITS
+	memcpy(traceBitTimes, code.traceBitTimes, code.messageLength < INLINE_LENGTH ? code.messageLength : INLINE_LENGTH);
+#endif
+#ifdef TRACE_LATENCY
+	queuedTime = code.queuedTime;
+	dequeuedTime = code.dequeuedTime;
+	decodedTime = code.decodedTime;
+#endif
+	return *this;
+}
+
+Code::Code(const char *message, uint8_t *overflow) {
 	bool trailing = false;
 
+	setOverflow(overflow);
 	valid = false;
 	messageLength = 0;
-	memset(this->message, 0, sizeof(this->message));
 
 	for (unsigned int i = 0; message[i] != 0; i++) {
 		if ((message[i] >= '0' && message[i] <= '9') || (message[i] >= 'A' && message[i] <= 'F')) {
 			uint8_t value = message[i] < 'A' ? (message[i] - '0') : ((message[i] - 'A') + 10);
+			uint8_t count = 4;
 
 			if (trailing) {
-				if (value & 0x8) {
-					if (messageLength + 3 <= MAX_LENGTH) {
-						this->message[messageLength / 8] |= (value & 0x7) << 5;
-						messageLength += 3;
-					}
-				} else if (value & 0x4) {
-					if (messageLength + 2 <= MAX_LENGTH) {
-						this->message[messageLength / 8] |= (value & 0x3) << 6;
-						messageLength += 2;
-					}
-				} else if (value & 0x2) {
-					if (messageLength + 1 <= MAX_LENGTH) {
-						this->message[messageLength / 8] |= (value & 0x1) << 7;
-						messageLength++;
-					}
-				}
-			} else {
-				if (messageLength + 4 <= MAX_LENGTH) {
-					this->message[messageLength / 8] |= value << (4 - (messageLength & 0x4));
-					messageLength += 4;
-				}
+				// Trailing bits are packed after a leading 1-bit
+				for (count = 3; count > 0 && !(value & (1 << count)); count--);
+				value &= (1 << count) - 1;
+			}
+
+			if (messageLength + count > capacity()) {
+				// Too long, the rest of the message is ignored
+				continue;
 			}
+
+			// Each byte is cleared when it's first used
+			if (!(messageLength & 0x7)) {
+				this->message[messageLength / 8] = 0;
+			}
+
+			this->message[messageLength / 8] |= value << (8 - (messageLength & 0x7) - count);
+			messageLength += count;
 		} else if (message[i] == '+') {
 			if (message[i + 1] == 0 || message[i + 2] != 0) {
 				return;
@@ -78,12 +131,18 @@ Code::Code(const char *message) {
 	}
 
 	duration = 0;
+	startTimestamp = 0;
+	endTimestamp = 0;
 	prePauseTime = 0;
 	postPauseTime = 0;
 	preambleTime[0] = 0;
 	preambleTime[1] = 0;
 	bitTotalTime[0] = 0;
 	bitTotalTime[1] = 0;
+	noiseRate = 0;
+	glitches = 0;
+	repeats = 0;
+	unresolved = 0;
 	prePauseStandalone = true;
 	postPausePresent = true;
 
@@ -94,6 +153,11 @@ bool Code::isValid() const {
 	return valid;
 }
 
+void Code::setOverflow(uint8_t *overflow) {
+	this->overflow = overflow;
+	message.overflow = overflow;
+}
+
 void Code::setValid(bool valid) {
 	this->valid = valid;
 }
@@ -106,6 +170,7 @@ enum class PreambleType {
 	LONG
 };
 
+template <class Policy>
 bool Code::finalise() {
 	bool hasPreamble;
 	PreambleType preambleType[2];
@@ -120,13 +185,13 @@ bool Code::finalise() {
 		bitTime[1] = oneBitCount > 0 ? (bitTotalTime[1] / oneBitCount) : 0;
 
 		for (unsigned int i = 0; i < 2; i++) {
-			if (preambleTime[i] < bitTime[0] * Receiver::MIN_ZERO_DURATION / Receiver::DIVISOR) {
+			if (preambleTime[i] < relativeDuration<Policy, Policy::MIN_ZERO_DURATION>(bitTime[0])) {
 				preambleType[i] = PreambleType::SHORT;
-			} else if (preambleTime[i] > bitTime[1] * Receiver::MAX_ONE_DURATION / Receiver::DIVISOR) {
+			} else if (preambleTime[i] > relativeDuration<Policy, Policy::MAX_ONE_DURATION>(bitTime[1])) {
 				preambleType[i] = PreambleType::LONG;
-			} else if (preambleTime[i] <= bitTime[0] * Receiver::MAX_ZERO_DURATION / Receiver::DIVISOR) {
+			} else if (preambleTime[i] <= relativeDuration<Policy, Policy::MAX_ZERO_DURATION>(bitTime[0])) {
 				preambleType[i] = PreambleType::ZERO;
-			} else if (preambleTime[i] >= bitTime[1] * Receiver::MIN_ONE_DURATION / Receiver::DIVISOR) {
+			} else if (preambleTime[i] >= relativeDuration<Policy, Policy::MIN_ONE_DURATION>(bitTime[1])) {
 				preambleType[i] = PreambleType::ONE;
 			} else {
 				preambleType[i] = PreambleType::MEDIUM;
@@ -145,7 +210,7 @@ bool Code::finalise() {
 #endif
 
 		if (preambleType[0] == PreambleType::ZERO && preambleType[1] >= PreambleType::ONE) {
-			if (preambleTime[1] > preambleTime[0] * Receiver::PREAMBLE_RELATIVE_DURATION / Receiver::DIVISOR) {
+			if (preambleTime[1] > relativeDuration<Policy, Policy::PREAMBLE_RELATIVE_DURATION>(preambleTime[0])) {
 				hasPreamble = true;
 			} else if (preambleType[1] == PreambleType::ONE) {
 				hasPreamble = false;
@@ -184,7 +249,7 @@ bool Code::finalise() {
 		bitTotalTime[preambleBits[1]] += preambleTime[1];
 
 		// Move all the bits up
-		for (unsigned int i = sizeof(message) - 1; i > 0; i--) {
+		for (unsigned int i = (messageLength + 2 + 7) / 8 - 1; i > 0; i--) {
 			message[i] = ((message[i - 1] << 6) & 0xC0) | ((message[i] >> 2) & 0x3F);
 		}
 		message[0] >>= 2;
@@ -200,53 +265,7 @@ bool Code::finalise() {
 	}
 
 	// Guess the missing final bit based on the other bit values in the message
-	const uint8_t trailingValue = messageTrailingValue();
-	uint8_t finalBit;
-	bool values1bit[1 << 1] = { false };
-	bool values2bit[1 << 2] = { false };
-	bool values3bit[1 << 3] = { false };
-	bool values4bit[1 << 4] = { false };
-
-	for (unsigned int i = 0; i < (messageLength >> 2); i++) {
-		values1bit[messageValueAt(i) >> 3] = true;
-		values2bit[messageValueAt(i) >> 2] = true;
-		values3bit[messageValueAt(i) >> 1] = true;
-		values4bit[messageValueAt(i)] = true;
-	}
-
-	switch (messageTrailingCount()) {
-	case 3:
-		if (values4bit[(trailingValue << 1) | 1]) {
-			finalBit = 1;
-		} else {
-			finalBit = 0;
-		}
-		break;
-
-	case 2:
-		if (values3bit[(trailingValue << 1) | 1]) {
-			finalBit = 1;
-		} else {
-			finalBit = 0;
-		}
-		break;
-
-	case 1:
-		if (values2bit[(trailingValue << 1) | 1]) {
-			finalBit = 1;
-		} else {
-			finalBit = 0;
-		}
-		break;
-
-	case 0:
-		if (values1bit[(trailingValue << 1) | 1]) {
-			finalBit = 1;
-		} else {
-			finalBit = 0;
-		}
-		break;
-	}
+	const uint8_t finalBit = messageGuessFinalBit();
 
 	const uint8_t value = 0x80 >> (messageLength & 0x07);
 	if (finalBit) {
@@ -260,7 +279,14 @@ bool Code::finalise() {
 	return true;
 }
 
-uint8_t inline Code::messageValueAt(uint8_t index) const {
+// Every policy that BasicReceiver is instantiated with in Receiver.cpp
+template bool Code::finalise<DefaultReceiverPolicy>();
+template bool Code::finalise<HomeEasyReceiverPolicy>();
+#ifdef DEBUG_TIMING
+template bool Code::finalise<DebugTimingReceiverPolicy>();
+#endif
+
+uint8_t inline Code::messageValueAt(unsigned int index) const {
 	return (message[index / 2] >> ((index & 1) ? 0 : 4)) & 0xF;
 }
 
@@ -273,13 +299,42 @@ uint8_t inline Code::messageTrailingValue() const {
 			& (0x7 >> (3 - messageTrailingCount()));
 }
 
+// Not all platforms can print 64-bit values
+static size_t printTimestamp(Print &p, uint64_t value) {
+	char buffer[21];
+	char *text = &buffer[sizeof(buffer) - 1];
+
+	*text = 0;
+	do {
+		*--text = '0' + (value % 10);
+		value /= 10;
+	} while (value);
+
+	return p.print(text);
+}
+
 static char toHex(uint8_t value) {
 	return (value < 10)
 		? (char)('0' + value)
 		: (char)('A' + (value - 10));
 }
 
+uint8_t Code::messageGuessFinalBit() const {
+	const uint8_t prefix = (messageTrailingValue() << 1) | 1;
+	// Number of 4-bit values that start with the trailing bits and a 1
+	const uint8_t width = 1 << (3 - messageTrailingCount());
+	uint16_t seen = 0;
+
+	for (unsigned int i = 0; i < (messageLength >> 2); i++) {
+		seen |= 1U << messageValueAt(i);
+	}
+
+	return ((seen >> (prefix * width)) & ((1U << width) - 1)) ? 1 : 0;
+}
+
 void Code::messageAsString(String &code, char &packedTrailingBits) const {
+	code.reserve(code.length() + (messageLength >> 2) + 1);
+
 	for (unsigned int i = 0; i < (messageLength >> 2); i++) {
 		code += toHex(messageValueAt(i));
 	}
@@ -296,36 +351,29 @@ void Code::messageAsString(String &code, char &packedTrailingBits) const {
 }
 
 void Code::messageCountBits(unsigned int &zeroBitCount, unsigned int &oneBitCount) const {
-	uint8_t value;
+	const unsigned int values = messageLength >> 2;
 
-	zeroBitCount = 0;
 	oneBitCount = 0;
-
-	for (unsigned int i = 0; i < (messageLength >> 2); i++) {
-		value = messageValueAt(i);
-
-		for (unsigned int bit = 0; bit < 4; bit++) {
-			if (value & (1U << bit)) {
-				oneBitCount++;
-			} else {
-				zeroBitCount++;
-			}
-		}
+	for (unsigned int i = 0; i < (values >> 1); i++) {
+		oneBitCount += __builtin_popcount(message[i]);
 	}
-
-	value = messageTrailingValue();
-	for (unsigned int bit = 0; bit < 3; bit++) {
-		if (value & (1U << bit)) {
-			oneBitCount++;
-		} else {
-			zeroBitCount++;
-		}
+	if (values & 1) {
+		oneBitCount += __builtin_popcount(message[values >> 1] & 0xF0);
 	}
+
+	// Always 3 trailing bits
+	oneBitCount += __builtin_popcount(messageTrailingValue());
+	zeroBitCount = values * 4 + 3 - oneBitCount;
 }
 
 size_t Code::printTo(Print &p) const {
 	size_t n = 0;
 	bool first = true;
+	bool validated = false;
+	bool lineCodings = false;
+	HomeEasyV1 homeEasyV1;
+	HomeEasyV2 homeEasyV2;
+	HomeEasyV3 homeEasyV3;
 	String code;
 	char packedTrailingBits;
 	unsigned int zeroBitCount;
@@ -352,6 +400,13 @@ size_t Code::printTo(Print &p) const {
 		n += p.print(",duration: ");
 		n += p.print(duration);
 
+		if (endTimestamp) {
+			n += p.print(",startTime: ");
+			n += printTimestamp(p, startTimestamp);
+			n += p.print(",endTime: ");
+			n += printTimestamp(p, endTimestamp);
+		}
+
 		n += p.print(",prePause: \"");
 		n += p.print(prePauseStandalone ? "standalone" : "following");
 		n += p.print("\",postPause: \"");
@@ -377,16 +432,68 @@ size_t Code::printTo(Print &p) const {
 			n += p.print(",oneBitDuration: ");
 			n += p.print(bitTotalTime[1] / oneBitCount);
 		}
+
+		if (glitches) {
+			n += p.print(",glitches: ");
+			n += p.print(glitches);
+		}
+
+		if (noiseRate) {
+			n += p.print(",noiseRate: ");
+			n += p.print(noiseRate);
+		}
+	}
+
+	if (repeats) {
+		n += p.print(",repeats: ");
+		n += p.print(repeats);
+		n += p.print(",confidence: ");
+		n += p.print(confidence);
+
+		if (unresolved) {
+			n += p.print(",unresolved: ");
+			n += p.print(unresolved);
+		}
 	}
 
 	if (postPausePresent) {
+		if (decodeHomeEasyV1(code, homeEasyV1)) {
+			validated = validated || homeEasyV1.validated;
+		}
+		if (decodeHomeEasyV2(code, homeEasyV2)) {
+			validated = validated || homeEasyV2.validated;
+		}
+		if (decodeHomeEasyV3(code, homeEasyV3)) {
+			validated = validated || homeEasyV3.validated;
+		}
+
+		// Don't demodulate codes a protocol has already validated, which
+		// would only add spurious decodes of them
+		lineCodings = !validated;
+		if (lineCodings) {
+			validated = validateLineCodings();
+		}
+
 		n += p.print(",decode: {");
-		n += printHomeEasyV1(first, code, p);
-		n += printHomeEasyV2(first, code, p);
-		n += printHomeEasyV3(first, code, p);
+		if (homeEasyV1.code.length()) {
+			n += printHomeEasyV1(first, homeEasyV1, p);
+		}
+		if (homeEasyV2.code.length()) {
+			n += printHomeEasyV2(first, homeEasyV2, p);
+		}
+		if (homeEasyV3.code.length()) {
+			n += printHomeEasyV3(first, homeEasyV3, p);
+		}
+		if (lineCodings) {
+			n += printLineCodings(first, p);
+		}
 		n += p.print('}');
 	}
 
+	// At least one of the decodes passed its checks
+	n += p.print(",validated: ");
+	n += p.print(validated ? "true" : "false");
+
 	n += p.print('}');
 
 #if 0
@@ -397,51 +504,49 @@ size_t Code::printTo(Print &p) const {
 	return n;
 }
 
-size_t Code::printHomeEasyV1(bool &first, const String &code, Print &p) const {
-	size_t n = 0;
-	String decoded;
-	int8_t group = -1;
-	int8_t device = -1;
-	String action;
+bool Code::decodeHomeEasyV1(const String &code, HomeEasyV1 &decoded) {
+	String &bits = decoded.code;
 
 	if (code.length() != 12) {
-		goto out;
+		return false;
 	}
 
 	for (const char c : code) {
 		switch (c) {
 		case '5':
-			decoded += '0';
+			bits += '0';
 			break;
 
 		case '6':
-			decoded += '1';
+			bits += '1';
 			break;
 
 		case 'A':
-			decoded += '2';
+			bits += '2';
 			break;
 
 		default:
-			goto out;
+			bits = "";
+			return false;
 		}
 	}
 
-	if (decoded.substring(0, 4).indexOf('2') == -1) {
-		group = ((uint8_t)(decoded[0] - '0') << 3)
-			| ((uint8_t)(decoded[1] - '0') << 2)
-			| ((uint8_t)(decoded[2] - '0') << 1)
-			| (uint8_t)(decoded[3] - '0');
+	if (bits.substring(0, 4).indexOf('2') == -1) {
+		decoded.group = ((uint8_t)(bits[0] - '0') << 3)
+			| ((uint8_t)(bits[1] - '0') << 2)
+			| ((uint8_t)(bits[2] - '0') << 1)
+			| (uint8_t)(bits[3] - '0');
 	}
 
-	if (decoded.substring(4, 8).indexOf('2') == -1) {
-		device = ((uint8_t)(decoded[4] - '0') << 3)
-			| ((uint8_t)(decoded[5] - '0') << 2)
-			| ((uint8_t)(decoded[6] - '0') << 1)
-			| (uint8_t)(decoded[7] - '0');
+	if (bits.substring(4, 8).indexOf('2') == -1) {
+		decoded.device = ((uint8_t)(bits[4] - '0') << 3)
+			| ((uint8_t)(bits[5] - '0') << 2)
+			| ((uint8_t)(bits[6] - '0') << 1)
+			| (uint8_t)(bits[7] - '0');
 	}
 
-	action = decoded.substring(8);
+	String &action = decoded.action;
+	action = bits.substring(8);
 	if (action == "0111") {
 		action = "on";
 	} else if (action == "0110") {
@@ -454,159 +559,111 @@ size_t Code::printHomeEasyV1(bool &first, const String &code, Print &p) const {
 		action = "";
 	}
 
-	if (first) {
-		first = false;
-	} else {
-		n += p.print(',');
-	}
-
-	n += p.print("HomeEasyV1: {code: \"");
-	n += p.print(decoded);
-	n += p.print('\"');
-	if (group >= 0) {
-		n += p.print(",group: ");
-		n += p.print(group);
-	}
-	if (device >= 0) {
-		n += p.print(",device: ");
-		n += p.print(device);
-	}
-	if (action != "") {
-		n += p.print(",action: \"");
-		n += p.print(action);
-		n += p.print('\"');
-	}
-	n += p.print('}');
-
-out:
-	return n;
+	decoded.validated = decoded.group >= 0 && decoded.device >= 0 && action != "";
+	return true;
 }
 
-size_t Code::printHomeEasyV2(bool &first, const String &code, Print &p) const {
-	size_t n = 0;
-	String decoded;
-	uint32_t group = 0;
-	uint8_t device = 0;
-	String action = "";
+bool Code::decodeHomeEasyV2(const String &code, HomeEasyV2 &decoded) {
+	String &bits = decoded.code;
 
 	if (code.length() != 29) {
-		goto out;
+		return false;
 	}
 
 	for (const char c : code) {
 		switch (c) {
 		case '0':
-			decoded += "00";
+			bits += "00";
 			break;
 
 		case '1':
-			decoded += "01";
+			bits += "01";
 			break;
 
 		case '4':
-			decoded += "10";
+			bits += "10";
 			break;
 
 		case '5':
-			decoded += "11";
+			bits += "11";
 			break;
 
 		default:
-			goto out;
+			bits = "";
+			return false;
 		}
 	}
 
 	// Ignore the last bit
-	decoded.remove(decoded.length() - 1);
+	bits.remove(bits.length() - 1);
 
-	if (decoded.substring(0, 11) != "11000111100") {
-		goto out;
+	if (bits.substring(0, 11) != "11000111100") {
+		bits = "";
+		return false;
 	}
 
 	for (unsigned int i = 0; i <= 31; i++) {
-		group |= (uint32_t)(uint8_t)(decoded[11 + (31 - i)] - '0') << i;
+		decoded.group |= (uint32_t)(uint8_t)(bits[11 + (31 - i)] - '0') << i;
 	}
 
-	if (decoded.substring(43, 47) == "1011" && decoded.substring(49, 51) == "01") {
-		if (decoded.substring(47, 49) == "01") {
-			action = "off";
-		} else if (decoded.substring(47, 49) == "10") {
-			action = "on";
+	if (bits.substring(43, 47) == "1011" && bits.substring(49, 51) == "01") {
+		if (bits.substring(47, 49) == "01") {
+			decoded.action = "off";
+		} else if (bits.substring(47, 49) == "10") {
+			decoded.action = "on";
 		}
-	} else if (decoded.substring(43, 47) == "1100" && decoded.substring(49, 51) == "11") {
-		if (decoded.substring(47, 49) == "01") {
-			action = "group off";
-		} else if (decoded.substring(47, 49) == "10") {
-			action = "group on";
+	} else if (bits.substring(43, 47) == "1100" && bits.substring(49, 51) == "11") {
+		if (bits.substring(47, 49) == "01") {
+			decoded.action = "group off";
+		} else if (bits.substring(47, 49) == "10") {
+			decoded.action = "group on";
 		}
 	}
 
 	for (unsigned int i = 0; i <= 6; i++) {
-		device |= (uint32_t)(uint8_t)(decoded[51 + (6 - i)] - '0') << i;
-	}
-
-	if (first) {
-		first = false;
-	} else {
-		n += p.print(',');
+		decoded.device |= (uint32_t)(uint8_t)(bits[51 + (6 - i)] - '0') << i;
 	}
 
-	n += p.print("HomeEasyV2: {code: \"");
-	n += p.print(decoded);
-	n += p.print('\"');
-	n += p.print(",group: ");
-	n += p.print(group);
-	n += p.print(",device: ");
-	n += p.print(device);
-	if (action != "") {
-		n += p.print(",action: \"");
-		n += p.print(action);
-		n += p.print('\"');
-	}
-	n += p.print('}');
-
-out:
-	return n;
+	decoded.validated = decoded.action != "";
+	return true;
 }
 
-size_t Code::printHomeEasyV3(bool &first, const String &code, Print &p) const {
-	size_t n = 0;
-	String decoded;
-	int32_t group = -1;
-	int8_t device = -1;
-	int8_t dimLevel = -1;
-	String action;
+bool Code::decodeHomeEasyV3(const String &code, HomeEasyV3 &decoded) {
+	String &bits = decoded.code;
+	String &action = decoded.action;
 
-	if (code.length() != 32 && code.length() != 36)
-		goto out;
+	if (code.length() != 32 && code.length() != 36) {
+		return false;
+	}
 
 	for (const char c : code) {
 		switch (c) {
 		case '1':
-			decoded += '0';
+			bits += '0';
 			break;
 
 		case '4':
-			decoded += '1';
+			bits += '1';
 			break;
 
 		case '0':
-			decoded += '2';
+			bits += '2';
 			break;
 
 		default:
-			goto out;
+			bits = "";
+			return false;
 		}
 	}
 
-	if (decoded.substring(0, 26).indexOf('2') == -1) {
-		group = 0;
+	if (bits.substring(0, 26).indexOf('2') == -1) {
+		decoded.group = 0;
 		for (unsigned int i = 0; i <= 25; i++) {
-			group |= (uint32_t)(uint8_t)(decoded[25 - i] - '0') << i;
+			decoded.group |= (uint32_t)(uint8_t)(bits[25 - i] - '0') << i;
 		}
 	}
 
-	switch (decoded[27]) {
+	switch (bits[27]) {
 	case '0':
 		action = "off";
 		break;
@@ -620,7 +677,7 @@ size_t Code::printHomeEasyV3(bool &first, const String &code, Print &p) const {
 		break;
 	}
 
-	switch (decoded[26]) {
+	switch (bits[26]) {
 	case '0':
 		break;
 
@@ -633,22 +690,94 @@ size_t Code::printHomeEasyV3(bool &first, const String &code, Print &p) const {
 		break;
 	}
 
-	if (decoded.substring(28, 32).indexOf('2') == -1) {
-		device = ((uint8_t)(decoded[28] - '0') << 3)
-			| ((uint8_t)(decoded[29] - '0') << 2)
-			| ((uint8_t)(decoded[30] - '0') << 1)
-			| (uint8_t)(decoded[31] - '0');
+	if (bits.substring(28, 32).indexOf('2') == -1) {
+		decoded.device = ((uint8_t)(bits[28] - '0') << 3)
+			| ((uint8_t)(bits[29] - '0') << 2)
+			| ((uint8_t)(bits[30] - '0') << 1)
+			| (uint8_t)(bits[31] - '0');
 	}
 
 	if (code.length() == 36) {
-		if (decoded.substring(32, 36).indexOf('2') == -1) {
-			dimLevel = ((uint8_t)(decoded[32] - '0') << 3)
-				| ((uint8_t)(decoded[33] - '0') << 2)
-				| ((uint8_t)(decoded[34] - '0') << 1)
-				| (uint8_t)(decoded[35] - '0');
+		if (bits.substring(32, 36).indexOf('2') == -1) {
+			decoded.dimLevel = ((uint8_t)(bits[32] - '0') << 3)
+				| ((uint8_t)(bits[33] - '0') << 2)
+				| ((uint8_t)(bits[34] - '0') << 1)
+				| (uint8_t)(bits[35] - '0');
 		}
 	}
 
+	// Only the action of a dim command can be a "2", which must have a dim level
+	decoded.validated = decoded.group != -1 && decoded.device != -1 && action != ""
+		&& (bits[27] == '2') == (code.length() == 36)
+		&& (code.length() != 36 || decoded.dimLevel != -1);
+	return true;
+}
+
+size_t Code::printHomeEasyV1(bool &first, const HomeEasyV1 &decoded, Print &p) {
+	size_t n = 0;
+
+	if (first) {
+		first = false;
+	} else {
+		n += p.print(',');
+	}
+
+	n += p.print("HomeEasyV1: {code: \"");
+	n += p.print(decoded.code);
+	n += p.print('\"');
+	if (decoded.validated) {
+		n += p.print(",validated: true");
+	}
+	if (decoded.group >= 0) {
+		n += p.print(",group: ");
+		n += p.print(decoded.group);
+	}
+	if (decoded.device >= 0) {
+		n += p.print(",device: ");
+		n += p.print(decoded.device);
+	}
+	if (decoded.action != "") {
+		n += p.print(",action: \"");
+		n += p.print(decoded.action);
+		n += p.print('\"');
+	}
+	n += p.print('}');
+
+	return n;
+}
+
+size_t Code::printHomeEasyV2(bool &first, const HomeEasyV2 &decoded, Print &p) {
+	size_t n = 0;
+
+	if (first) {
+		first = false;
+	} else {
+		n += p.print(',');
+	}
+
+	n += p.print("HomeEasyV2: {code: \"");
+	n += p.print(decoded.code);
+	n += p.print('\"');
+	if (decoded.validated) {
+		n += p.print(",validated: true");
+	}
+	n += p.print(",group: ");
+	n += p.print(decoded.group);
+	n += p.print(",device: ");
+	n += p.print(decoded.device);
+	if (decoded.action != "") {
+		n += p.print(",action: \"");
+		n += p.print(decoded.action);
+		n += p.print('\"');
+	}
+	n += p.print('}');
+
+	return n;
+}
+
+size_t Code::printHomeEasyV3(bool &first, const HomeEasyV3 &decoded, Print &p) {
+	size_t n = 0;
+
 	if (first) {
 		first = false;
 	} else {
@@ -656,27 +785,109 @@ size_t Code::printHomeEasyV3(bool &first, const String &code, Print &p) const {
 	}
 
 	n += p.print("HomeEasyV3: {code: \"");
-	n += p.print(decoded);
+	n += p.print(decoded.code);
 	n += p.print('\"');
-	if (group != -1) {
+	if (decoded.validated) {
+		n += p.print(",validated: true");
+	}
+	if (decoded.group != -1) {
 		n += p.print(",group: ");
-		n += p.print(group);
+		n += p.print(decoded.group);
 	}
-	if (device != -1) {
+	if (decoded.device != -1) {
 		n += p.print(",device: ");
-		n += p.print(device);
+		n += p.print(decoded.device);
 	}
-	if (action != "") {
+	if (decoded.action != "") {
 		n += p.print(",action: \"");
-		n += p.print(action);
+		n += p.print(decoded.action);
 		n += p.print('\"');
 	}
-	if (dimLevel != -1) {
+	if (decoded.dimLevel != -1) {
 		n += p.print(",dimLevel: ");
-		n += p.print(dimLevel * 67 / 10);
+		n += p.print(decoded.dimLevel * 67 / 10);
 	}
 	n += p.print('}');
 
-out:
+	return n;
+}
+
+const Checksum *Code::findChecksum(const Code &bits) {
+	if (bits.messageLength % 8 != 0) {
+		return nullptr;
+	}
+
+	for (unsigned int i = 0; i < Checksum::COUNT; i++) {
+		if (Checksum::ALL[i]->verify(bits.message, bits.messageLength / 8)) {
+			return Checksum::ALL[i];
+		}
+	}
+
+	return nullptr;
+}
+
+bool Code::validateLineCodings() const {
+	// There are no more bits than pulses
+	uint8_t bitsOverflow[OVERFLOW_SIZE];
+
+	for (unsigned int i = 0; i < LineCoding::COUNT; i++) {
+		Code bits;
+
+		bits.setOverflow(bitsOverflow);
+
+		if (LineCoding::ALL[i]->demodulate(*this, bits) && bits.messageLength >= LineCoding::MIN_BITS
+				&& findChecksum(bits) != nullptr) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+size_t Code::printLineCodings(bool &first, Print &p) const {
+	size_t n = 0;
+	// There are no more bits than pulses
+	uint8_t bitsOverflow[OVERFLOW_SIZE];
+
+	for (unsigned int i = 0; i < LineCoding::COUNT; i++) {
+		const LineCoding *lineCoding = LineCoding::ALL[i];
+		Code bits;
+		String code;
+		char packedTrailingBits;
+
+		bits.setOverflow(bitsOverflow);
+
+		if (!lineCoding->demodulate(*this, bits) || bits.messageLength < LineCoding::MIN_BITS) {
+			continue;
+		}
+
+		bits.messageAsString(code, packedTrailingBits);
+
+		if (first) {
+			first = false;
+		} else {
+			n += p.print(',');
+		}
+
+		n += p.print(lineCoding->name());
+		n += p.print(": {code: \"");
+		n += p.print(code);
+		if (packedTrailingBits != 0) {
+			n += p.print('+');
+			n += p.print(packedTrailingBits);
+		}
+		n += p.print("\",bits: ");
+		n += p.print(bits.messageLength);
+
+		// The last byte is the checksum of the others
+		const Checksum *checksum = findChecksum(bits);
+		if (checksum != nullptr) {
+			n += p.print(",checksum: \"");
+			n += p.print(checksum->name());
+			n += p.print("\",validated: true");
+		}
+		n += p.print('}');
+	}
+
 	return n;
 }
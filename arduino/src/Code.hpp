@@ -22,51 +22,163 @@
 #include <Arduino.h>
 
 //#define TRACE_BITS
+//#define TRACE_LATENCY
 
-class Receiver;
+// Maximum length of a code in bits (without the 2 preamble bits)
+#ifndef CODE_MAX_LENGTH
+# if defined(ARDUINO_ARCH_AVR)
+#  define CODE_MAX_LENGTH (96 * 4 - 2)
+# else
+#  define CODE_MAX_LENGTH (256 * 4 - 2)
+# endif
+#endif
+
+// Length of a code in bits (without the 2 preamble bits) that is stored
+// in every code, the rest of a longer code is stored in a separate
+// overflow buffer that only the receivers and their output have
+#ifndef CODE_INLINE_LENGTH
+# define CODE_INLINE_LENGTH (48 * 4 - 2)
+#endif
+
+template <class Policy> class BasicReceiver;
+class Checksum;
 
 class Code: public Printable {
-	friend Receiver;
+	template <class Policy> friend class BasicReceiver;
+	friend class Burst;
 
 public:
 	Code();
-	Code(const char *message);
+	Code(const char *message, uint8_t *overflow = nullptr);
+	Code(const Code &code);
 	virtual ~Code();
+	Code &operator=(const Code &code);
 	virtual size_t printTo(Print &p) const __attribute__((warn_unused_result));
 	bool isValid() const;
 
 	// Without the 2 bits that are handled as the preamble times
 	static constexpr uint8_t MIN_LENGTH = 12 * 4 - 2;
-	static constexpr uint8_t MAX_LENGTH = 48 * 4 - 2;
+	static constexpr unsigned int MAX_LENGTH = CODE_MAX_LENGTH;
+	static constexpr unsigned int INLINE_LENGTH = CODE_INLINE_LENGTH < CODE_MAX_LENGTH
+		? CODE_INLINE_LENGTH : CODE_MAX_LENGTH;
+
+	// Add 2 bits extra space for the preamble bits during finalisation
+	static constexpr unsigned int INLINE_SIZE = (INLINE_LENGTH + 7 + 2) / 8;
+	static constexpr unsigned int OVERFLOW_SIZE = (MAX_LENGTH + 7 + 2) / 8 - INLINE_SIZE;
+
+	// Bytes of the message, with any after the inline bytes in the
+	// overflow buffer (if there is one)
+	struct Message {
+		uint8_t bytes[INLINE_SIZE];
+		uint8_t *overflow = nullptr;
+
+		inline uint8_t &operator[](unsigned int index) {
+			return index < INLINE_SIZE ? bytes[index] : overflow[index - INLINE_SIZE];
+		}
+
+		inline uint8_t operator[](unsigned int index) const {
+			return index < INLINE_SIZE ? bytes[index] : overflow[index - INLINE_SIZE];
+		}
+	};
 
-	uint8_t message[(MAX_LENGTH + 7 + 2) / 8]; // Add 2 bits extra space for the preamble bits during finalisation
+	// Store the part of the message after the inline bytes in a buffer
+	// of OVERFLOW_SIZE bytes, which is where a long code that's copied
+	// to this code is copied to (without one, a copy of a long code
+	// shares the buffer of the code it was copied from)
+	void setOverflow(uint8_t *overflow);
+	// Has its own overflow buffer for a long code
+	inline bool hasOverflow() const { return overflow != nullptr; }
+	// Maximum length of the message
+	inline unsigned int capacity() const {
+		return message.overflow != nullptr ? MAX_LENGTH : INLINE_LENGTH;
+	}
+	// Part of the message is in the overflow buffer
+	inline bool isLong() const {
+		return messageLength > INLINE_SIZE * 8;
+	}
+
+	Message message;
 	unsigned int messageLength;
 
 protected:
+	uint8_t *overflow = nullptr;
+
 	void setValid(bool valid);
-	bool finalise();
+	template <class Policy> bool finalise();
 
-	uint8_t messageValueAt(uint8_t index) const;
+	uint8_t messageValueAt(unsigned int index) const;
 	uint8_t messageTrailingCount() const;
 	uint8_t messageTrailingValue() const;
+	uint8_t messageGuessFinalBit() const;
 	void messageAsString(String &code, char &packedTrailingBits) const;
 	void messageCountBits(unsigned int &zeroBitCount, unsigned int &oneBitCount) const;
 
-	size_t printHomeEasyV1(bool &first, const String &code, Print &p) const __attribute__((warn_unused_result));
-	size_t printHomeEasyV2(bool &first, const String &code, Print &p) const __attribute__((warn_unused_result));
-	size_t printHomeEasyV3(bool &first, const String &code, Print &p) const __attribute__((warn_unused_result));
+	// Protocols are decoded (and validated) before the code is output,
+	// the fields that aren't valid are -1 or empty
+	struct HomeEasyV1 {
+		String code;
+		int8_t group = -1;
+		int8_t device = -1;
+		String action;
+		bool validated = false;
+	};
+
+	struct HomeEasyV2 {
+		String code;
+		uint32_t group = 0;
+		uint8_t device = 0;
+		String action;
+		bool validated = false;
+	};
+
+	struct HomeEasyV3 {
+		String code;
+		int32_t group = -1;
+		int8_t device = -1;
+		int8_t dimLevel = -1;
+		String action;
+		bool validated = false;
+	};
+
+	// Returns false if the code is not the protocol
+	static bool decodeHomeEasyV1(const String &code, HomeEasyV1 &decoded);
+	static bool decodeHomeEasyV2(const String &code, HomeEasyV2 &decoded);
+	static bool decodeHomeEasyV3(const String &code, HomeEasyV3 &decoded);
+	// The demodulated message of a line coding has a matching checksum
+	bool validateLineCodings() const;
+	// Checksum that matches the demodulated message (if any)
+	static const Checksum *findChecksum(const Code &bits);
+
+	static size_t printHomeEasyV1(bool &first, const HomeEasyV1 &decoded, Print &p) __attribute__((warn_unused_result));
+	static size_t printHomeEasyV2(bool &first, const HomeEasyV2 &decoded, Print &p) __attribute__((warn_unused_result));
+	static size_t printHomeEasyV3(bool &first, const HomeEasyV3 &decoded, Print &p) __attribute__((warn_unused_result));
+	size_t printLineCodings(bool &first, Print &p) const __attribute__((warn_unused_result));
 
 	unsigned long duration;
+	unsigned long endTime;
+	uint64_t startTimestamp; // Time of the first edge (64-bit micros())
+	uint64_t endTimestamp; // Time of the last edge (64-bit micros())
 	unsigned long prePauseTime;
 	unsigned long postPauseTime;
 	unsigned long preambleTime[2];
 	unsigned long bitTotalTime[2];
+	uint16_t noiseRate; // Noise edges per second before the code
+	uint8_t glitches; // Short pulses that were merged into bits
+	uint8_t repeats; // Number of codes combined into this code
+	uint8_t confidence; // Percentage of combined bits that agree
+	uint16_t unresolved; // Combined bits with a tied vote
 	bool prePauseStandalone : 1;
 	bool postPausePresent : 1;
 	bool valid : 1;
 
 #ifdef TRACE_BITS
-	uint8_t traceBitTimes[MAX_LENGTH];
+	uint8_t traceBitTimes[INLINE_LENGTH]; // Not traced for the rest of a long code
+#endif
+#ifdef TRACE_LATENCY
+	// Time of each stage after the end of the code
+	unsigned long queuedTime; // Added to the receiver's buffer
+	unsigned long dequeuedTime; // Removed from the receiver's buffer
+	unsigned long decodedTime; // Finalised and checked for duplicates
 #endif
 };
 
@@ -0,0 +1,124 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Histogram.hpp"
+
+#include <Arduino.h>
+
+Histogram *Histogram::first = nullptr;
+Histogram *Histogram::last = nullptr;
+void (*volatile Histogram::stopOtherCore)() = nullptr;
+void (*volatile Histogram::resumeOtherCore)() = nullptr;
+
+Histogram::Histogram(const char *group, const char *name)
+		: group(group), name(name) {
+	if (last != nullptr) {
+		last->next = this;
+	} else {
+		first = this;
+	}
+	last = this;
+}
+
+Histogram::~Histogram() {
+	Histogram *previous = nullptr;
+
+	for (Histogram *histogram = first; histogram != nullptr; histogram = histogram->next) {
+		if (histogram == this) {
+			if (previous != nullptr) {
+				previous->next = next;
+			} else {
+				first = next;
+			}
+
+			if (last == this) {
+				last = previous;
+			}
+			break;
+		}
+		previous = histogram;
+	}
+}
+
+void Histogram::setOtherCore(void (*stop)(), void (*resume)()) {
+	resumeOtherCore = resume;
+	stopOtherCore = stop;
+}
+
+void Histogram::printAll(Print *output) {
+	void (*const stop)() = stopOtherCore;
+	void (*const resume)() = resumeOtherCore;
+
+	const char *current = nullptr;
+
+	for (Histogram *histogram = first; histogram != nullptr; histogram = histogram->next) {
+		uint16_t counts[BUCKETS];
+		unsigned int length = 0;
+
+		// The interrupt handlers could be updating it
+		if (stop != nullptr) {
+			stop();
+		}
+		noInterrupts();
+		memcpy(counts, histogram->counts, sizeof(counts));
+		memset(histogram->counts, 0, sizeof(histogram->counts));
+		interrupts();
+		if (resume != nullptr) {
+			resume();
+		}
+
+		for (unsigned int i = 0; i < BUCKETS; i++) {
+			if (counts[i]) {
+				length = i + 1;
+			}
+		}
+
+		if (!length) {
+			continue;
+		}
+
+		if (current != histogram->group) {
+			if (current != nullptr) {
+				output->println('}');
+			}
+
+			output->print("stats: {group: \"");
+			output->print(histogram->group);
+			output->print('\"');
+			current = histogram->group;
+		}
+
+		output->print(',');
+		output->print(histogram->name);
+		output->print(": [");
+		for (unsigned int i = 0; i < length; i++) {
+			if (i > 0) {
+				output->print(',');
+			}
+			output->print(counts[i]);
+		}
+		output->print(']');
+	}
+
+	if (current != nullptr) {
+		output->println('}');
+	} else {
+		// There's always a response to a request for the statistics
+		output->println("stats: {}");
+	}
+}
@@ -0,0 +1,77 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RF433_OOK_HISTOGRAM_HPP
+#define RF433_OOK_HISTOGRAM_HPP
+
+#include <Arduino.h>
+
+// Counts of durations (µs) on a log2 scale, which are cheap enough to
+// update in an interrupt handler: bucket 0 is for 0µs, bucket n is for
+// [2^(n-1), 2^n) µs and the last bucket is for anything longer
+//
+// Every histogram is added to a list so that they can all be output
+// (and removed from the list when it is destroyed). When another core
+// runs interrupt handlers that update them it must be stopped while each
+// histogram is read and reset.
+class Histogram {
+public:
+	static constexpr unsigned int BUCKETS = 10;
+
+	Histogram(const char *group, const char *name);
+	~Histogram();
+	Histogram(const Histogram&) = delete;
+	Histogram& operator=(const Histogram&) = delete;
+
+	inline void add(unsigned long value) {
+		uint8_t bucket = BUCKETS - 1;
+
+		if (value < (1UL << (BUCKETS - 2))) {
+			// Avoid 32-bit shifts on 8-bit platforms
+			uint16_t remaining = value;
+
+			for (bucket = 0; remaining; bucket++) {
+				remaining >>= 1;
+			}
+		}
+
+		if (counts[bucket] < UINT16_MAX) {
+			counts[bucket]++;
+		}
+	}
+
+	// Output the histograms that have any values (one line per group)
+	// and then reset them
+	static void printAll(Print *output);
+
+	// Functions to stop and resume the other core
+	static void setOtherCore(void (*stop)(), void (*resume)());
+
+private:
+	static Histogram *first;
+	static Histogram *last;
+	static void (*volatile stopOtherCore)();
+	static void (*volatile resumeOtherCore)();
+
+	const char *group;
+	const char *name;
+	Histogram *next = nullptr;
+	uint16_t counts[BUCKETS] = { 0 };
+};
+
+#endif
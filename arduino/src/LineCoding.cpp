@@ -0,0 +1,134 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LineCoding.hpp"
+
+#include <Arduino.h>
+
+static const ManchesterLineCoding manchester;
+static const PWMLineCoding pwm;
+static const PPMLineCoding ppm;
+
+const LineCoding *const LineCoding::ALL[] = { &manchester, &pwm, &ppm };
+const unsigned int LineCoding::COUNT = sizeof(ALL) / sizeof(ALL[0]);
+
+bool LineCoding::addBit(Code &bits, uint8_t bit) {
+	const uint8_t value = 0x80 >> (bits.messageLength & 0x07);
+
+	if (bits.messageLength >= bits.capacity()) {
+		return false;
+	}
+
+	if (bit) {
+		bits.message[bits.messageLength / 8] |= value;
+	} else {
+		bits.message[bits.messageLength / 8] &= ~value;
+	}
+	bits.messageLength++;
+	return true;
+}
+
+bool ManchesterLineCoding::demodulate(const Code &pulses, Code &bits) const {
+	// A leading low half-bit is part of the pause before the code
+	return demodulate(pulses, bits, false) || demodulate(pulses, bits, true);
+}
+
+bool ManchesterLineCoding::demodulate(const Code &pulses, Code &bits, bool leadingLow) {
+	const unsigned int count = pulseCount(pulses);
+	bool pending = leadingLow;
+	uint8_t pendingLevel = 0;
+
+	bits.messageLength = 0;
+
+	for (unsigned int i = 0; i < count; i++) {
+		const uint8_t level = (i & 1) ? 0 : 1;
+
+		// Long pulses are two half-bits
+		for (unsigned int half = 0; half <= pulseAt(pulses, i); half++) {
+			if (!pending) {
+				pendingLevel = level;
+				pending = true;
+			} else if (pendingLevel == level) {
+				// No transition in the middle of the bit
+				return false;
+			} else {
+				if (!addBit(bits, level)) {
+					return false;
+				}
+				pending = false;
+			}
+		}
+	}
+
+	if (pending) {
+		if (pendingLevel) {
+			// The final low half-bit is part of the pause after the code
+			return addBit(bits, 0);
+		} else {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool PWMLineCoding::demodulate(const Code &pulses, Code &bits) const {
+	const unsigned int count = pulseCount(pulses);
+
+	bits.messageLength = 0;
+
+	if (count == 0) {
+		return false;
+	}
+
+	for (unsigned int i = 0; i + 1 < count; i += 2) {
+		const uint8_t high = pulseAt(pulses, i);
+
+		if (high == pulseAt(pulses, i + 1)) {
+			return false;
+		}
+
+		if (!addBit(bits, high)) {
+			return false;
+		}
+	}
+
+	// The final low pulse is part of the pause after the code
+	return addBit(bits, pulseAt(pulses, count - 1));
+}
+
+bool PPMLineCoding::demodulate(const Code &pulses, Code &bits) const {
+	const unsigned int count = pulseCount(pulses);
+
+	bits.messageLength = 0;
+
+	for (unsigned int i = 0; i < count; i += 2) {
+		if (pulseAt(pulses, i)) {
+			// High pulses must be short
+			return false;
+		}
+
+		if (i + 1 < count) {
+			if (!addBit(bits, pulseAt(pulses, i + 1))) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
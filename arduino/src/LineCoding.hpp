@@ -0,0 +1,89 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RF433_OOK_LINECODING_HPP
+#define RF433_OOK_LINECODING_HPP
+
+#include <Arduino.h>
+
+#include "Code.hpp"
+
+// Demodulates the pulses of a received code into logical bits
+//
+// Each bit of the received message is a short (0) or long (1) pulse, with
+// the level alternating between high and low (starting with high after the
+// pause). A final low pulse is ignored because it's part of the pause after
+// the code (the receiver guesses its value).
+class LineCoding {
+public:
+	virtual ~LineCoding() {}
+	virtual const char *name() const = 0;
+
+	// Returns false if the pulses are not valid for this line coding
+	virtual bool demodulate(const Code &pulses, Code &bits) const = 0;
+
+	// All of the line codings that are output for received codes
+	static const LineCoding *const ALL[];
+	static const unsigned int COUNT;
+
+	// Minimum number of demodulated bits to output
+	static constexpr unsigned int MIN_BITS = 8;
+
+protected:
+	// Number of pulses up to the final high pulse
+	static inline unsigned int pulseCount(const Code &pulses) {
+		return (pulses.messageLength & 1) ? pulses.messageLength
+			: (pulses.messageLength > 0 ? pulses.messageLength - 1 : 0);
+	}
+
+	static inline uint8_t pulseAt(const Code &pulses, unsigned int index) {
+		return (pulses.message[index / 8] >> (7 - (index & 0x07))) & 1;
+	}
+
+	static bool addBit(Code &bits, uint8_t bit);
+};
+
+// Two half-bit periods with a transition in the middle of each bit,
+// high then low for a 0-bit and low then high for a 1-bit (IEEE 802.3)
+class ManchesterLineCoding: public LineCoding {
+public:
+	const char *name() const override { return "Manchester"; }
+	bool demodulate(const Code &pulses, Code &bits) const override;
+
+private:
+	static bool demodulate(const Code &pulses, Code &bits, bool leadingLow);
+};
+
+// Pulse width modulation as a pair of high and low pulses,
+// short/long for a 0-bit and long/short for a 1-bit
+class PWMLineCoding: public LineCoding {
+public:
+	const char *name() const override { return "PWM"; }
+	bool demodulate(const Code &pulses, Code &bits) const override;
+};
+
+// Pulse distance (position) modulation with short high pulses,
+// a short low pulse for a 0-bit and a long low pulse for a 1-bit
+// (with a final high pulse to end the last bit)
+class PPMLineCoding: public LineCoding {
+public:
+	const char *name() const override { return "PPM"; }
+	bool demodulate(const Code &pulses, Code &bits) const override;
+};
+
+#endif
@@ -18,10 +18,19 @@
 
 #include <limits.h>
 
+#include "Burst.hpp"
+#include "Clock.hpp"
+#include "Histogram.hpp"
 #include "Main.hpp"
+#include "Queue.hpp"
 #include "Receiver.hpp"
 #include "Transmitter.hpp"
 
+#ifdef RX_SECOND_CORE
+# include <hardware/gpio.h>
+# include <pico/multicore.h>
+#endif
+
 #ifdef ARDUINO_AVR_MICRO
 static int freeMemory() {
 	extern int __heap_start, *__brkval;
@@ -45,11 +54,99 @@ static void checkFreeMemory() {
 }
 #endif
 
+constexpr unsigned int RX_COUNT = sizeof(RX_PINS) / sizeof(RX_PINS[0]);
+static_assert(RX_COUNT <= Receiver::MAX_RECEIVERS, "Too many receivers");
+
+Receiver receivers[RX_COUNT];
+static Burst burst;
 Transmitter transmitter(TX_PIN, TX_SILENT);
 
+#if defined(DEBUG_TIMING) && !defined(RX_SECOND_CORE)
+// Run a second receiver with a protocol specific policy on the same input
+// to compare the cost of its interrupt handler (codes are output twice)
+static BasicReceiver<DebugTimingReceiverPolicy> comparisonReceiver;
+
+static void comparisonInterruptHandler() {
+	receivers[0].interruptHandler();
+	comparisonReceiver.interruptHandler();
+}
+#endif
+
+#ifdef RX_SECOND_CORE
+// Codes decoded by the second core, waiting for output by the first core
+static Queue<Code, 16> decodedCodes;
+// Overflow buffer for one long code at a time in the queue, which is
+// in use until the first core has output the code
+static uint8_t decodedOverflow[Code::OVERFLOW_SIZE];
+static volatile bool decodedOverflowUsed = false;
+
+static void secondCoreInterruptHandler(uint gpio, uint32_t events) {
+	(void)events;
+
+	for (unsigned int i = 0; i < RX_COUNT; i++) {
+		if ((uint)digitalPinToPinName(RX_PINS[i]) == gpio) {
+			receivers[i].interruptHandler();
+		}
+	}
+}
+
+static void secondCore() {
+	// Interrupts are handled by the core that enables them, but mbed's
+	// attachInterrupt() allocates memory and uses locks that are only
+	// safe on the first core so the receivers are attached there and
+	// their interrupts are enabled here with the Pico SDK
+	for (unsigned int i = 0; i < RX_COUNT; i++) {
+		gpio_set_irq_enabled_with_callback(digitalPinToPinName(RX_PINS[i]),
+			GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true, secondCoreInterruptHandler);
+	}
+
+	// The histograms updated by the interrupt handlers are output by the
+	// first core, which stops this core (with interrupts disabled) while
+	// it reads and resets each one
+	multicore_lockout_victim_init();
+	Histogram::setOtherCore(multicore_lockout_start_blocking, multicore_lockout_end_blocking);
+
+	while (true) {
+		Clock::update();
+
+		for (unsigned int i = 0; i < RX_COUNT; i++) {
+			Code code;
+
+			// Long codes stay queued by the receiver until it's available
+			if (!decodedOverflowUsed) {
+				code.setOverflow(decodedOverflow);
+			}
+
+			if (receivers[i].decodeCode(code)) {
+				if (code.isLong()) {
+					decodedOverflowUsed = true;
+				}
+
+				if (!decodedCodes.push(code) && code.isLong()) {
+					decodedOverflowUsed = false;
+				}
+			}
+		}
+	}
+}
+#endif
+
 void setup() {
 	if (RX_ENABLED) {
-		receiver.attach(RX_PIN);
+#ifdef RX_SECOND_CORE
+		for (unsigned int i = 0; i < RX_COUNT; i++) {
+			receivers[i].attach(RX_PINS[i], false);
+		}
+		multicore_launch_core1(secondCore);
+#else
+		for (unsigned int i = 0; i < RX_COUNT; i++) {
+			receivers[i].attach(RX_PINS[i]);
+		}
+# ifdef DEBUG_TIMING
+		comparisonReceiver.attach(RX_PINS[0]);
+		attachInterrupt(digitalPinToInterrupt(RX_PINS[0]), comparisonInterruptHandler, CHANGE);
+# endif
+#endif
 	}
 
 	if (TX_ENABLED) {
@@ -66,13 +163,35 @@ void loop() {
 #endif
 
 		if (RX_ENABLED) {
+#ifdef RX_SECOND_CORE
+			Code code;
+
+			while (decodedCodes.pop(code)) {
+				Receiver::printCode(console, code);
+				burst.add(console, code);
+
+				if (code.isLong()) {
+					decodedOverflowUsed = false;
+				}
+			}
+#else
 			static unsigned long last = millis();
 			unsigned long now = millis();
 
+			Clock::update();
+
 			if (now - last >= 20) {
 				last = now;
-				receiver.printCode(console);
+				for (unsigned int i = 0; i < RX_COUNT; i++) {
+					receivers[i].printCode(console, &burst);
+				}
+# ifdef DEBUG_TIMING
+				comparisonReceiver.printCode(console);
+# endif
 			}
+#endif
+
+			burst.expire(console, micros());
 		}
 	}
 
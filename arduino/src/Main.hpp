@@ -31,16 +31,21 @@ constexpr unsigned long CONSOLE_BAUD_RATE = 115200;
 
 // 433MHz OOK
 constexpr bool RX_ENABLED = true;
+// Up to 3 receivers (e.g. for antenna diversity or other frequencies)
 #if defined(ARDUINO_AVR_MICRO)
-constexpr int RX_PIN = 2;
+constexpr int RX_PINS[] = { 2 };
 #elif defined(ARDUINO_AVR_UNO)
-constexpr int RX_PIN = 2;
+constexpr int RX_PINS[] = { 2 };
 #elif defined(ARDUINO_AVR_MEGA2560)
-constexpr int RX_PIN = 2;
+constexpr int RX_PINS[] = { 2 };
 #elif defined(ARDUINO_RASPBERRY_PI_PICO)
-constexpr int RX_PIN = 9;
+constexpr int RX_PINS[] = { 9 };
 #elif defined(ARDUINO_ESP32C3_DEV)
-constexpr int RX_PIN = 6;
+constexpr int RX_PINS[] = { 6 };
+#endif
+#if defined(ARDUINO_RASPBERRY_PI_PICO)
+// Receive and decode on the second core, with output on the first core
+# define RX_SECOND_CORE
 #endif
 constexpr bool TX_ENABLED = true;
 constexpr bool TX_SILENT = false;
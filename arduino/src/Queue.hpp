@@ -0,0 +1,70 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RF433_OOK_QUEUE_HPP
+#define RF433_OOK_QUEUE_HPP
+
+// Lock-free queue for one producer and one consumer, which can
+// be on different cores. Items are dropped if the queue is full.
+template <class T, unsigned int N>
+class Queue {
+public:
+	// Producer only
+	bool push(const T &item) {
+		const unsigned int write = writeIndex;
+		const unsigned int next = (write + 1 >= SIZE) ? 0 : (write + 1);
+
+		if (next == __atomic_load_n(&readIndex, __ATOMIC_ACQUIRE)) {
+			__atomic_store_n(&dropped, dropped + 1, __ATOMIC_RELAXED);
+			return false;
+		}
+
+		items[write] = item;
+		__atomic_store_n(&writeIndex, next, __ATOMIC_RELEASE);
+		return true;
+	}
+
+	// Consumer only
+	bool pop(T &item) {
+		const unsigned int read = readIndex;
+
+		if (read == __atomic_load_n(&writeIndex, __ATOMIC_ACQUIRE)) {
+			return false;
+		}
+
+		item = items[read];
+		__atomic_store_n(&readIndex, (read + 1 >= SIZE) ? 0 : (read + 1), __ATOMIC_RELEASE);
+		return true;
+	}
+
+	// Number of items that could not be added because the queue was full
+	unsigned long droppedCount() const {
+		return __atomic_load_n(&dropped, __ATOMIC_RELAXED);
+	}
+
+private:
+	// One slot is always empty to distinguish between full and empty
+	static constexpr unsigned int SIZE = N + 1;
+
+	T items[SIZE];
+	unsigned int readIndex = 0;
+	unsigned int writeIndex = 0;
+	unsigned long dropped = 0;
+};
+
+#endif
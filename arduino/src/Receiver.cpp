@@ -48,12 +48,12 @@
 #include <limits.h>
 #include <stdint.h>
 
+#include "Clock.hpp"
+#include "Histogram.hpp"
 #include "Receiver.hpp"
+#include "TransmitSchedule.hpp"
 
-Receiver receiver;
-
-//#define DEBUG_TIMING
-#ifdef DEBUG_TIMING
+// Paths through the interrupt handler (in the same order as rf433-simavr-bench)
 enum HandlerTiming {
 	TIMING_OTHER,
 	TIMING_PAUSE_STANDALONE,
@@ -64,58 +64,132 @@ enum HandlerTiming {
 	TIMING_SAMPLE_ONE,
 	TIMING_SAMPLE_SWAP,
 	TIMING_SAMPLE_COMPLETE,
+	TIMING_ECHO,
+	TIMING_NOISE,
 	LEN_TIMING
 };
 
-uint8_t handlerTimesMin[LEN_TIMING] = { 255 };
-uint8_t handlerTimesMax[LEN_TIMING] = { 0 };
-#endif
+// Separate timing for each policy so that they can be compared
+template <class Policy>
+struct HandlerTimes {
+	static Histogram handler[LEN_TIMING];
+	static Histogram interruptsDisabled;
+};
+
+template <class Policy>
+Histogram HandlerTimes<Policy>::handler[LEN_TIMING] = {
+	{ Policy::name(), "other" },
+	{ Policy::name(), "pauseStandalone" },
+	{ Policy::name(), "pauseFollowing" },
+	{ Policy::name(), "zeroBit" },
+	{ Policy::name(), "oneBit" },
+	{ Policy::name(), "sampleZero" },
+	{ Policy::name(), "sampleOne" },
+	{ Policy::name(), "sampleSwap" },
+	{ Policy::name(), "sampleComplete" },
+	{ Policy::name(), "echo" },
+	{ Policy::name(), "noise" },
+};
 
-Receiver::Receiver() {
+// Time spent reading codes with interrupts disabled
+template <class Policy>
+Histogram HandlerTimes<Policy>::interruptsDisabled = { Policy::name(), "interruptsDisabled" };
 
+template <class Policy>
+BasicReceiver<Policy> *BasicReceiver<Policy>::instances[MAX_RECEIVERS] = { nullptr };
+
+// Interrupt handlers can't have any arguments, so there's a separate
+// function for each receiver that calls its handler
+template <class Policy>
+void (*const BasicReceiver<Policy>::TRAMPOLINES[MAX_RECEIVERS])() = {
+	interruptTrampoline<0>,
+	interruptTrampoline<1>,
+	interruptTrampoline<2>,
+};
+
+template <class Policy>
+template <unsigned int Index>
+void BasicReceiver<Policy>::interruptTrampoline() {
+	instances[Index]->interruptHandler();
 }
 
-Receiver::~Receiver() {
+template <class Policy>
+BasicReceiver<Policy>::BasicReceiver() {
+	static_assert(MAX_CODES + MAX_CONTEXTS <= UINT8_MAX, "Too many codes");
+
+	for (unsigned int i = 0; i < MAX_CODES; i++) {
+		queue[i] = i;
+	}
+
+	for (unsigned int i = 0; i < MAX_CONTEXTS; i++) {
+		contexts[i].slot = MAX_CODES + i;
+	}
+}
 
+template <class Policy>
+BasicReceiver<Policy>::~BasicReceiver() {
+	detach();
 }
 
-void Receiver::attach(int pin) {
-	pinMode(pin, INPUT);
-	attachInterrupt(digitalPinToInterrupt(pin), interruptHandler, CHANGE);
+template <class Policy>
+void BasicReceiver<Policy>::attach(int pin, bool interrupt) {
+	detach();
+
+	for (unsigned int i = 0; i < MAX_RECEIVERS; i++) {
+		if (instances[i] == nullptr) {
+			instances[i] = this;
+			this->pin = pin;
+
+			pinMode(pin, INPUT);
+			if (interrupt) {
+				attachInterrupt(digitalPinToInterrupt(pin), TRAMPOLINES[i], CHANGE);
+			}
+			return;
+		}
+	}
 }
 
-struct ReceiverTiming {
-	// Sampling
-	unsigned long sampleMinTime[2];
-	unsigned long sampleMaxTime[2];
-	bool sampleComplete;
+template <class Policy>
+void BasicReceiver<Policy>::detach() {
+	if (pin == -1) {
+		return;
+	}
 
-	// Timing
-	unsigned long bitTime[2];
+	detachInterrupt(digitalPinToInterrupt(pin));
+	pin = -1;
 
-	// Message
-	unsigned long start;
-};
+	for (unsigned int i = 0; i < MAX_RECEIVERS; i++) {
+		if (instances[i] == this) {
+			instances[i] = nullptr;
+		}
+	}
+}
 
-// These take about 4µs each, so it's better to do some of them
-// every time than to add to the work required to process a pause
+// These take about 4µs each (unless the policy has power of 2 relative
+// durations), so it's better to do some of them every time than to
+// add to the work required to process a pause
+template <class Policy>
 static inline unsigned long minZeroPeriod(const ReceiverTiming &data) {
-	return data.bitTime[0] * Receiver::MIN_ZERO_DURATION / Receiver::DIVISOR;
+	return relativeDuration<Policy, Policy::MIN_ZERO_DURATION>(data.bitTime[0]);
 }
 
+template <class Policy>
 static inline unsigned long maxZeroPeriod(const ReceiverTiming &data) {
-	return data.bitTime[0] * Receiver::MAX_ZERO_DURATION / Receiver::DIVISOR;
+	return relativeDuration<Policy, Policy::MAX_ZERO_DURATION>(data.bitTime[0]);
 }
 
+template <class Policy>
 static inline unsigned long minOnePeriod(const ReceiverTiming &data) {
-	return data.bitTime[1] * Receiver::MIN_ONE_DURATION / Receiver::DIVISOR;
+	return relativeDuration<Policy, Policy::MIN_ONE_DURATION>(data.bitTime[1]);
 }
 
+template <class Policy>
 static inline unsigned long maxOnePeriod(const ReceiverTiming &data) {
-	return data.bitTime[1] * Receiver::MAX_ONE_DURATION / Receiver::DIVISOR;
+	return relativeDuration<Policy, Policy::MAX_ONE_DURATION>(data.bitTime[1]);
 }
 
-inline void Receiver::addBit(Code *code, uint8_t bit, const unsigned long &duration) {
+template <class Policy>
+inline void BasicReceiver<Policy>::addBit(Code *code, uint8_t bit, const unsigned long &duration) {
 	const uint8_t value = 0x80 >> (code->messageLength & 0x07);
 
 	if (bit) {
@@ -125,7 +199,9 @@ inline void Receiver::addBit(Code *code, uint8_t bit, const unsigned long &durat
 	}
 
 #ifdef TRACE_BITS
-	if ((duration >> 4) < 255) {
+	if (code->messageLength >= Code::INLINE_LENGTH) {
+		// Not traced
+	} else if ((duration >> 4) < 255) {
 		code->traceBitTimes[code->messageLength] = (duration >> 4);
 	} else {
 		code->traceBitTimes[code->messageLength] = 255;
@@ -135,6 +211,12 @@ inline void Receiver::addBit(Code *code, uint8_t bit, const unsigned long &durat
 	code->bitTotalTime[bit] += duration;
 }
 
+template <class Policy>
+inline void BasicReceiver<Policy>::removeBit(Code *code, const unsigned long &duration) {
+	code->messageLength--;
+	code->bitTotalTime[(code->message[code->messageLength / 8] >> (7 - (code->messageLength & 0x07))) & 1] -= duration;
+}
+
 template <typename T>
 static inline void swap(T *values) {
 	T tmp = values[0];
@@ -142,236 +224,440 @@ static inline void swap(T *values) {
 	values[1] = tmp;
 }
 
-void Receiver::interruptHandler() {
-	static unsigned long last = 0;
-	static bool pause = false;
-	static bool prePauseStandalone = true;
-	static ReceiverTiming data;
-	static Code *code = nullptr;
-	unsigned long now = micros();
-	unsigned long duration = now - last;
-#ifdef DEBUG_TIMING
-	HandlerTiming timingType = TIMING_OTHER;
-#endif
+// Called at the end of each noise period (only while not receiving a code)
+template <class Policy>
+void BasicReceiver<Policy>::updateNoise(unsigned long now) {
+	if (now - noiseStart >= 2 * NOISE_PERIOD_US) {
+		// Quiet for at least a whole period
+		noiseEdges = 0;
+	}
 
-retry:
-	if (!pause) {
-		if (duration >= MIN_PAUSE_US) {
-			code = &receiver.codes[receiver.codeWriteIndex];
-
-			data.sampleMinTime[0] = ~0;
-			data.sampleMinTime[1] = ~0;
-			data.sampleMaxTime[0] = 0;
-			data.sampleMaxTime[1] = 0;
-			data.sampleComplete = false;
-			code->messageLength = 0;
-			code->preambleTime[0] = 0;
-			code->preambleTime[1] = 0;
-			data.bitTime[0] = 0;
-			data.bitTime[1] = 0;
-			code->bitTotalTime[0] = 0;
-			code->bitTotalTime[1] = 0;
-			data.start = now;
-			code->prePauseTime = duration;
-
-			pause = true;
+	noiseRate = (noiseEdges * 1000000UL) / NOISE_PERIOD_US;
 
-#ifdef DEBUG_TIMING
-			// The time taken for each of these is different, because
-			// when one message follows another we do more work by
-			// restarting the handler to reset and reinterpret the pause
-			if (prePauseStandalone) {
-				timingType = TIMING_PAUSE_STANDALONE;
-			} else {
-				timingType = TIMING_PAUSE_FOLLOWING;
-			}
-#endif
-		} else {
-			prePauseStandalone = true;
+	if (noiseEdges >= FLOOD_NOISE_EDGES) {
+		if (minPauseTime + FLOOD_PAUSE_STEP_US <= FLOOD_MAX_PAUSE_US) {
+			minPauseTime += FLOOD_PAUSE_STEP_US;
+		}
+	} else if (minPauseTime > MIN_PAUSE_US) {
+		minPauseTime -= FLOOD_PAUSE_STEP_US;
+	}
+
+	noiseStart = now;
+	noiseEdges = 0;
+}
+
+// Start decoding a code after a pause in a free context (any existing
+// contexts continue if they accepted the pause as a bit)
+template <class Policy>
+void BasicReceiver<Policy>::startCode(unsigned long now, unsigned long duration, bool standalone) {
+	for (ReceiverContext &context : contexts) {
+		if (context.active) {
+			continue;
 		}
+
+		Code &code = codes[context.slot];
+		ReceiverTiming &data = context.data;
+
+		data.sampleMinTime[0] = ~0;
+		data.sampleMinTime[1] = ~0;
+		data.sampleMaxTime[0] = 0;
+		data.sampleMaxTime[1] = 0;
+		data.sampleComplete = false;
+		code.messageLength = 0;
+		code.preambleTime[0] = 0;
+		code.preambleTime[1] = 0;
+		data.bitTime[0] = 0;
+		data.bitTime[1] = 0;
+		code.bitTotalTime[0] = 0;
+		code.bitTotalTime[1] = 0;
+		data.glitchable = false;
+		data.invalid = false;
+		data.start = now;
+		code.glitches = 0;
+		code.prePauseTime = duration;
+		code.prePauseStandalone = standalone;
+		code.postPausePresent = false;
+		code.noiseRate = noiseRate;
+
+		context.last = now;
+		context.active = true;
+		receiving = true;
+		break;
+	}
+
+	// The time taken for each of these is different, because
+	// when one message follows another we do more work by
+	// ending the previous message first
+	if (standalone) {
+		timingType = TIMING_PAUSE_STANDALONE;
 	} else {
-		bool postPausePresent = false;
-
-		if (duration < MIN_BIT_US) {
-			// Too short
-			goto error;
-		} else if (code->preambleTime[0] == 0) {
-			if (duration > MAX_BIT_US) {
-				// Too long
-				goto error;
+		timingType = TIMING_PAUSE_FOLLOWING;
+	}
+}
+
+// Give the code being decoded by a context the overflow buffer, if no
+// other code is using it (returns false if the code can't be extended)
+template <class Policy>
+bool BasicReceiver<Policy>::extendCode(ReceiverContext &context) {
+	if (overflowSlot != NO_SLOT) {
+		// Queued codes are valid
+		if (codes[overflowSlot].isValid()) {
+			return false;
+		}
+
+		for (const ReceiverContext &other : contexts) {
+			if (other.active && other.slot == overflowSlot) {
+				return false;
 			}
-			code->preambleTime[0] = duration;
-			goto done;
-		} else if (code->preambleTime[1] == 0) {
-			if (duration > MAX_BIT_US) {
-				// Too long
-				goto error;
+		}
+
+		codes[overflowSlot].setOverflow(nullptr);
+	}
+
+	codes[context.slot].setOverflow(overflow);
+	overflowSlot = context.slot;
+	return true;
+}
+
+template <class Policy>
+typename BasicReceiver<Policy>::EdgeResult BasicReceiver<Policy>::endCode(ReceiverContext &context,
+		unsigned long end, unsigned long duration, bool postPausePresent) {
+	Code &code = codes[context.slot];
+
+	code.postPausePresent = postPausePresent;
+
+	// Check min length (but we can't receive the final bit)
+	if (code.messageLength >= Code::MIN_LENGTH - 1) {
+		code.duration = (end - context.data.start) + context.data.bitTime[1];
+		code.endTime = end;
+		code.postPauseTime = duration;
+		return EdgeResult::COMPLETE;
+	} else {
+		// Code too short
+		return EdgeResult::FAILED;
+	}
+}
+
+template <class Policy>
+typename BasicReceiver<Policy>::EdgeResult BasicReceiver<Policy>::processEdge(ReceiverContext &context,
+		unsigned long now) {
+	const unsigned long duration = now - context.last;
+	Code &code = codes[context.slot];
+	ReceiverTiming &data = context.data;
+	bool postPausePresent = false;
+
+	if (duration < MIN_BIT_US) {
+		if ((data.glitchable || data.invalid) && code.glitches < MAX_GLITCHES) {
+			// Merge the previous pulse with this glitch, so that the time
+			// from the start of the previous pulse to the next edge is
+			// processed as one bit
+			if (data.glitchable) {
+				removeBit(&code, context.last - data.bitStart);
 			}
-			code->preambleTime[1] = duration;
-			goto done;
-		} else if (code->messageLength == Code::MAX_LENGTH - 1) { // We can't receive the final bit
-			// Code too long
-		} else if (!data.sampleComplete) {
-			if (duration > MAX_BIT_US) {
-				// Too long
-				goto error;
-				} else {
-				bool bit;
-
-				if (data.bitTime[0] == 0) {
-					// Assume first duration is 0-bit
-					data.bitTime[0] = duration;
-
-					bit = 0;
-	#ifdef DEBUG_TIMING
-					timingType = TIMING_SAMPLE_ZERO;
-	#endif
-				} else if (duration >= data.bitTime[0] * Receiver::MIN_RELATIVE_DURATION / Receiver::DIVISOR) {
-					if (data.bitTime[1] == 0) {
-						// This bit looks like a 1-bit relative to the duration of the
-						// currently known 0-bit, this is now the duration of the 1-bit
-						data.bitTime[1] = duration;
-					} else {
-						// This looks like another 1-bit, average it into the timing
-						data.bitTime[1] += duration;
-						data.bitTime[1] /= 2;
-					}
-
-					bit = 1;
-	#ifdef DEBUG_TIMING
-					timingType = TIMING_SAMPLE_ONE;
-	#endif
-				} else if (data.bitTime[0] >= duration * Receiver::MIN_RELATIVE_DURATION / Receiver::DIVISOR) {
-					// If the currently known 0-bit looks like a 1-bit relative to
-					// this bit then the previous bits were 1-bits and this is now
-					// the duration of the 0-bit
-					data.bitTime[1] = data.bitTime[0];
-					data.bitTime[0] = duration;
-
-					swap(data.sampleMinTime);
-					swap(data.sampleMaxTime);
-					swap(code->bitTotalTime);
-
-					// Invert previously stored bits
-					for (unsigned int i = 0; i < ((code->messageLength + 7) >> 3); i++) {
-						code->message[i] = ~code->message[i];
-					}
-
-					bit = 0;
-	#ifdef DEBUG_TIMING
-					timingType = TIMING_SAMPLE_SWAP;
-	#endif
+			code.glitches++;
+			data.glitchable = false;
+			data.invalid = false;
+			context.last = data.bitStart;
+			return EdgeResult::CONTINUE;
+		} else if (data.invalid) {
+			goto invalid;
+		}
+
+		// Too short
+		return EdgeResult::FAILED;
+	} else if (data.invalid) {
+		goto invalid;
+	} else if (code.preambleTime[0] == 0) {
+		if (duration > MAX_BIT_US) {
+			// Too long
+			return EdgeResult::FAILED;
+		}
+		code.preambleTime[0] = duration;
+		goto done;
+	} else if (code.preambleTime[1] == 0) {
+		if (duration > MAX_BIT_US) {
+			// Too long
+			return EdgeResult::FAILED;
+		}
+		code.preambleTime[1] = duration;
+		goto done;
+	} else if (code.messageLength == code.capacity() - 1 // We can't receive the final bit
+			&& (code.capacity() == Code::MAX_LENGTH || !extendCode(context))) {
+		// Code too long
+	} else if (!data.sampleComplete) {
+		if (duration > MAX_BIT_US) {
+			// Too long
+			return EdgeResult::FAILED;
+			} else {
+			bool bit;
+
+			if (data.bitTime[0] == 0) {
+				// Assume first duration is 0-bit
+				data.bitTime[0] = duration;
+
+				bit = 0;
+				timingType = TIMING_SAMPLE_ZERO;
+			} else if (duration >= relativeDuration<Policy, MIN_RELATIVE_DURATION>(data.bitTime[0])) {
+				if (data.bitTime[1] == 0) {
+					// This bit looks like a 1-bit relative to the duration of the
+					// currently known 0-bit, this is now the duration of the 1-bit
+					data.bitTime[1] = duration;
 				} else {
-					// This looks like another 0-bit, average it into the timing
-					data.bitTime[0] += duration;
-					data.bitTime[0] /= 2;
-
-					bit = 0;
-	#ifdef DEBUG_TIMING
-					timingType = TIMING_SAMPLE_ZERO;
-	#endif
+					// This looks like another 1-bit, average it into the timing
+					data.bitTime[1] += duration;
+					data.bitTime[1] /= 2;
 				}
 
-				addBit(code, bit, duration);
-
-				if (duration < data.sampleMinTime[bit]) {
-					data.sampleMinTime[bit] = duration;
+				bit = 1;
+				timingType = TIMING_SAMPLE_ONE;
+			} else if (data.bitTime[0] >= relativeDuration<Policy, MIN_RELATIVE_DURATION>(duration)) {
+				// If the currently known 0-bit looks like a 1-bit relative to
+				// this bit then the previous bits were 1-bits and this is now
+				// the duration of the 0-bit
+				data.bitTime[1] = data.bitTime[0];
+				data.bitTime[0] = duration;
+
+				swap(data.sampleMinTime);
+				swap(data.sampleMaxTime);
+				swap(code.bitTotalTime);
+
+				// Invert previously stored bits
+				for (unsigned int i = 0; i < ((code.messageLength + 7) >> 3); i++) {
+					code.message[i] = ~code.message[i];
 				}
 
-				if (duration > data.sampleMaxTime[bit]) {
-					data.sampleMaxTime[bit] = duration;
-				}
+				bit = 0;
+				timingType = TIMING_SAMPLE_SWAP;
+			} else {
+				// This looks like another 0-bit, average it into the timing
+				data.bitTime[0] += duration;
+				data.bitTime[0] /= 2;
 
-				if (code->messageLength >= Receiver::MIN_SAMPLES && data.bitTime[0] != 0 && data.bitTime[1] != 0) {
-					// Both bit durations have been detected, check the existing timings
-					if (data.sampleMinTime[0] < minZeroPeriod(data) || data.sampleMaxTime[0] > maxZeroPeriod(data)
-							|| data.sampleMinTime[1] < minOnePeriod(data) || data.sampleMaxTime[1] > maxOnePeriod(data)) {
-						// Oops
-						goto error;
-					}
-
-	#ifdef DEBUG_TIMING
-					timingType = TIMING_SAMPLE_COMPLETE;
-	#endif
-
-					data.sampleComplete = true;
-				} else if (code->messageLength >= Receiver::MAX_SAMPLES) {
-					// Unable to identify periods after all sampling
-					goto error;
-				}
+				bit = 0;
+				timingType = TIMING_SAMPLE_ZERO;
+			}
+
+			addBit(&code, bit, duration);
 
-				goto done;
+			if (duration < data.sampleMinTime[bit]) {
+				data.sampleMinTime[bit] = duration;
 			}
-		} else if (duration >= MIN_PAUSE_US) {
-			postPausePresent = true;
-		} else if (duration >= minZeroPeriod(data) && duration <= maxOnePeriod(data)) {
-			if (duration <= maxZeroPeriod(data)) {
-				addBit(code, 0, duration);
-#ifdef DEBUG_TIMING
-				timingType = TIMING_HANDLER_ZERO;
-#endif
-				goto done;
-			} else if (duration >= minOnePeriod(data)) {
-				addBit(code, 1, duration);
-#ifdef DEBUG_TIMING
-				timingType = TIMING_HANDLER_ONE;
-#endif
-				goto done;
-			} else {
-				// Invalid duration
+
+			if (duration > data.sampleMaxTime[bit]) {
+				data.sampleMaxTime[bit] = duration;
+			}
+
+			if (code.messageLength >= MIN_SAMPLES && data.bitTime[0] != 0 && data.bitTime[1] != 0) {
+				// Both bit durations have been detected, check the existing timings
+				if (data.sampleMinTime[0] < minZeroPeriod<Policy>(data) || data.sampleMaxTime[0] > maxZeroPeriod<Policy>(data)
+						|| data.sampleMinTime[1] < minOnePeriod<Policy>(data) || data.sampleMaxTime[1] > maxOnePeriod<Policy>(data)) {
+					// Oops
+					return EdgeResult::FAILED;
+				}
+
+				timingType = TIMING_SAMPLE_COMPLETE;
+
+				data.sampleComplete = true;
+			} else if (code.messageLength >= MAX_SAMPLES) {
+				// Unable to identify periods after all sampling
+				return EdgeResult::FAILED;
 			}
+
+			goto done;
+		}
+	} else if (duration >= MIN_PAUSE_US) {
+		postPausePresent = true;
+	} else if (duration >= minZeroPeriod<Policy>(data) && duration <= maxOnePeriod<Policy>(data)) {
+		data.bitStart = context.last;
+		data.glitchable = true;
+
+		if (duration <= maxZeroPeriod<Policy>(data)) {
+			addBit(&code, 0, duration);
+			timingType = TIMING_HANDLER_ZERO;
+			goto done;
+		} else if (duration >= minOnePeriod<Policy>(data)) {
+			addBit(&code, 1, duration);
+			timingType = TIMING_HANDLER_ONE;
+			goto done;
 		} else {
 			// Invalid duration
 		}
+	} else {
+		// Invalid duration
+	}
+
+	if (!postPausePresent && data.sampleComplete && duration <= maxOnePeriod<Policy>(data)
+			&& code.glitches < MAX_GLITCHES && code.messageLength < Code::MAX_LENGTH - 1) {
+		// This could be the first part of a bit that has a glitch
+		// in it, wait for the next edge before ending the code
+		data.bitStart = context.last;
+		data.glitchable = false;
+		data.invalid = true;
+		goto done;
+	}
 
-		// Check min length (but we can't receive the final bit)
-		if (code->messageLength >= Code::MIN_LENGTH - 1) {
-			code->duration = (last - data.start) + data.bitTime[1];
-			code->postPauseTime = duration;
-			code->prePauseStandalone = prePauseStandalone;
-			code->postPausePresent = postPausePresent;
+	return endCode(context, context.last, duration, postPausePresent);
 
-			code = nullptr;
-			receiver.addCode();
-		} else {
-			// Code too short
+invalid:
+	// End the code before the previous (invalid) pulse
+	return endCode(context, data.bitStart, context.last - data.bitStart, false);
+
+done:
+	context.last = now;
+	return EdgeResult::CONTINUE;
+}
+
+template <class Policy>
+void BasicReceiver<Policy>::interruptHandler() {
+#if defined(BENCH_CYCLES) && defined(ARDUINO_ARCH_AVR)
+	// Start of the handler for rf433-simavr-bench
+	GPIOR1 = 0;
+#endif
+
+	const unsigned long now = micros();
+	const unsigned long duration = now - last;
+
+	if (!receiving && duration < MIN_BIT_US) {
+		// Too short to start a code, so there's nothing to do
+		// except count it (a flood of noise has a lot of these)
+		if (TransmitSchedule::isEcho(now, ECHO_US)) {
+			echoes++;
+		} else if (noiseEdges < MAX_NOISE_EDGES) {
+			noiseEdges++;
 		}
 
-error:
-		// Restart, reusing the current pause duration
-		pause = false;
-		prePauseStandalone = !postPausePresent;
-		goto retry;
+		if (now - noiseStart >= NOISE_PERIOD_US) {
+			updateNoise(now);
+		}
+
+		last = now;
+
+		// Not timed to avoid reading the time again, rf433-simavr-bench
+		// counts the cycles taken by this path
+#if defined(BENCH_CYCLES) && defined(ARDUINO_ARCH_AVR)
+		GPIOR0 = TIMING_NOISE;
+#endif
+		return;
 	}
 
-done:
-	last = now;
+	const uint64_t timestamp = Clock::extend(now);
+	const bool echo = TransmitSchedule::isEcho(now, ECHO_US);
+	ReceiverContext *completed = nullptr;
+	bool following = false;
 
-#ifdef DEBUG_TIMING
-	unsigned long timingValue = micros() - now;
-	if (timingValue > 255) {
-		timingValue = 255;
+	timingType = TIMING_OTHER;
+
+	if (!echo && duration < MIN_BIT_US && noiseEdges < MAX_NOISE_EDGES) {
+		noiseEdges++;
+	}
+
+	if (receiving) {
+		receiving = false;
+
+		for (ReceiverContext &context : contexts) {
+			if (!context.active) {
+				continue;
+			}
+
+			switch (processEdge(context, now)) {
+			case EdgeResult::CONTINUE:
+				receiving = true;
+				break;
+
+			case EdgeResult::FAILED:
+				context.active = false;
+				following = following || codes[context.slot].postPausePresent;
+				break;
+
+			case EdgeResult::COMPLETE:
+				context.active = false;
+				following = following || codes[context.slot].postPausePresent;
+
+				// Prefer the code that started first
+				if (completed == nullptr || context.data.start - completed->data.start > LONG_MAX) {
+					completed = &context;
+				}
+				break;
+			}
+		}
+
+		if (completed != nullptr) {
+			Code &code = codes[completed->slot];
+			const uint8_t slot = queue[codeWriteIndex];
+
+			// Other contexts that started before the end of the code are
+			// decoding the same transmission, but a context that started
+			// after it is decoding the next one
+			receiving = false;
+			for (ReceiverContext &context : contexts) {
+				if (!context.active) {
+					continue;
+				}
+
+				if (code.endTime - context.data.start - 1 < LONG_MAX) {
+					context.active = false;
+				} else {
+					receiving = true;
+				}
+			}
+
+			code.startTimestamp = timestamp - (now - completed->data.start);
+			code.endTimestamp = timestamp - (now - code.endTime);
+#ifdef TRACE_LATENCY
+			code.queuedTime = now;
+#endif
+
+			// Queue the completed code and give its context the
+			// (unused) code that was at the end of the queue
+			queue[codeWriteIndex] = completed->slot;
+			completed->slot = slot;
+			addCode();
+		}
 	}
 
-	if (handlerTimesMin[timingType] > timingValue) {
-		handlerTimesMin[timingType] = timingValue;
+	if (echo) {
+		// Our own transmission can end a code that was received in the
+		// pause before it, but nothing else can be received until the
+		// next pause
+		for (ReceiverContext &context : contexts) {
+			context.active = false;
+		}
+		receiving = false;
+		echoes++;
+		timingType = TIMING_ECHO;
+		goto done;
+	}
+
+	if (!receiving && now - noiseStart >= NOISE_PERIOD_US) {
+		updateNoise(now);
 	}
 
-	if (handlerTimesMax[timingType] < timingValue) {
-		handlerTimesMax[timingType] = timingValue;
+	if (duration >= minPauseTime) {
+		// A pause that ends a code (even if it's too short) is not standalone
+		startCode(now, duration, !following);
 	}
+
+done:
+	last = now;
+
+	HandlerTimes<Policy>::handler[timingType].add(micros() - now);
+
+#if defined(BENCH_CYCLES) && defined(ARDUINO_ARCH_AVR)
+	// End of the handler and the path through it
+	GPIOR0 = timingType;
 #endif
 }
 
-void Receiver::addCode() {
-	codes[codeWriteIndex].setValid(true);
+template <class Policy>
+void BasicReceiver<Policy>::addCode() {
+	codes[queue[codeWriteIndex]].setValid(true);
 	codeWriteIndex++;
 	if (codeWriteIndex >= MAX_CODES) {
 		codeWriteIndex = 0;
 	}
 
-	if (codes[codeWriteIndex].isValid()) {
-		codes[codeWriteIndex].setValid(false);
+	if (codes[queue[codeWriteIndex]].isValid()) {
+		codes[queue[codeWriteIndex]].setValid(false);
 
 		// assert(codeReadIndex == codeWriteIndex);
 
@@ -380,43 +666,146 @@ void Receiver::addCode() {
 			codeReadIndex = 0;
 		}
 
-		// assert(codes[codeReadIndex].isValid());
+		// assert(codes[queue[codeReadIndex]].isValid());
 	}
 }
 
-void Receiver::printCode(Print *output) {
-	noInterrupts();
-#ifdef DEBUG_TIMING
-	unsigned long timeRead = micros();
-#endif
+// Check if another receiver has recently received the same code, and
+// record this code so that the other receivers can do the same (codes
+// from each receiver can be output in a different order, so more than
+// one recent code is kept)
+template <class Policy>
+bool BasicReceiver<Policy>::isDuplicate(const Code &code) {
+	bool duplicate = false;
+	// Only the bits used by the code are compared (FNV-1a)
+	uint32_t hash = 2166136261UL;
+
+	for (unsigned int i = 0; i < (code.messageLength + 7) / 8; i++) {
+		uint8_t value = code.message[i];
+
+		if (i == code.messageLength / 8) {
+			value &= 0xFF << (8 - (code.messageLength & 0x07));
+		}
+		hash = (hash ^ value) * 16777619UL;
+	}
+
+	for (unsigned int i = 0; i < MAX_RECEIVERS && !duplicate; i++) {
+		const BasicReceiver *other = instances[i];
+
+		if (other == nullptr || other == this) {
+			continue;
+		}
+
+		for (const RecentCode &recent : other->recent) {
+			// The same transmission will end within a pause of the
+			// other receiver (in either direction)
+			if (recent.messageLength == code.messageLength
+					&& code.endTime - recent.endTime + MIN_PAUSE_US < 2 * MIN_PAUSE_US
+					&& recent.hash == hash) {
+				duplicate = true;
+				break;
+			}
+		}
+	}
+
+	recent[recentIndex].hash = hash;
+	recent[recentIndex].messageLength = code.messageLength;
+	recent[recentIndex].endTime = code.endTime;
+	recentIndex++;
+	if (recentIndex >= RECENT_CODES) {
+		recentIndex = 0;
+	}
+
+	return duplicate;
+}
 
-	if (codes[codeReadIndex].isValid()) {
-		Code code = codes[codeReadIndex];
-		codes[codeReadIndex].setValid(false);
+// Interrupts must be disabled, a code that's too long for the inline
+// message (after finalisation) stays queued until it can be copied to
+// a code with its own overflow buffer
+template <class Policy>
+bool BasicReceiver<Policy>::dequeueCode(Code &code) {
+	Code &queued = codes[queue[codeReadIndex]];
+
+	if (queued.isValid() && (code.hasOverflow()
+			|| queued.messageLength + 3 <= Code::INLINE_SIZE * 8)) {
+		code = queued;
+		queued.setValid(false);
 		codeReadIndex++;
 		if (codeReadIndex >= MAX_CODES) {
 			codeReadIndex = 0;
 		}
-#ifdef DEBUG_TIMING
-		timeRead = micros() - timeRead;
+		return true;
+	}
+
+	return false;
+}
+
+template <class Policy>
+bool BasicReceiver<Policy>::decodeCode(Code &code) {
+	bool dequeued;
+
+	noInterrupts();
+	const unsigned long start = micros();
+	dequeued = dequeueCode(code);
+	HandlerTimes<Policy>::interruptsDisabled.add(micros() - start);
+	interrupts();
+
+	if (dequeued && code.finalise<Policy>() && !isDuplicate(code)) {
+#ifdef TRACE_LATENCY
+		code.dequeuedTime = start;
+		code.decodedTime = micros();
+#endif
+		return true;
+	}
 
-		uint8_t copyHandlerTimesMin[LEN_TIMING];
-		uint8_t copyHandlerTimesMax[LEN_TIMING];
+	return false;
+}
 
-		memcpy(copyHandlerTimesMin, handlerTimesMin, sizeof(handlerTimesMin));
-		memcpy(copyHandlerTimesMax, handlerTimesMax, sizeof(handlerTimesMax));
-		memset(handlerTimesMin, 255, sizeof(handlerTimesMin));
-		memset(handlerTimesMax, 0, sizeof(handlerTimesMax));
+template <class Policy>
+void BasicReceiver<Policy>::printCode(Print *output, const Code &code) {
+	output->print("receive: ");
+	output->println(code);
+
+#ifdef TRACE_LATENCY
+	// Wait for the line to be sent instead of only buffered
+	output->flush();
+	const unsigned long outputTime = micros();
+
+	output->print("latency: {endTime: ");
+	output->print(code.endTime);
+	output->print(",queued: ");
+	output->print(code.queuedTime - code.endTime);
+	output->print(",dequeued: ");
+	output->print(code.dequeuedTime - code.endTime);
+	output->print(",decoded: ");
+	output->print(code.decodedTime - code.endTime);
+	output->print(",output: ");
+	output->print(outputTime - code.endTime);
+	output->println('}');
 #endif
-		interrupts();
+}
+
+template <class Policy>
+void BasicReceiver<Policy>::printCode(Print *output, Burst *burst) {
+	static uint8_t outputOverflow[Code::OVERFLOW_SIZE];
+	Code code;
+
+	code.setOverflow(outputOverflow);
+
+	noInterrupts();
+	const unsigned long start = micros();
+	const bool dequeued = dequeueCode(code);
+	HandlerTimes<Policy>::interruptsDisabled.add(micros() - start);
+	interrupts();
 
+	if (dequeued) {
 #ifdef TRACE_BITS
 		output->print("# -2\t");
 		output->println(code.preambleTime[0]);
 		output->print("# -1\t");
 		output->println(code.preambleTime[1]);
 
-		for (unsigned int i = 0; i < code.messageLength; i++) {
+		for (unsigned int i = 0; i < code.messageLength && i < Code::INLINE_LENGTH; i++) {
 			output->print("# ");
 			output->print(i);
 			output->print('\t');
@@ -427,76 +816,29 @@ void Receiver::printCode(Print *output) {
 		}
 #endif
 
-		if (code.finalise()) {
-			output->print("receive: ");
-			output->println(code);
+		if (code.finalise<Policy>() && !isDuplicate(code)) {
+#ifdef TRACE_LATENCY
+			code.dequeuedTime = start;
+			code.decodedTime = micros();
+#endif
+			printCode(output, code);
+
+			if (burst != nullptr) {
+				burst->add(output, code);
+			}
 		}
 
 #ifdef DEBUG_TIMING
-		output->print("timing: {read: ");
-		output->print(timeRead);
-
-		if (copyHandlerTimesMax[TIMING_PAUSE_STANDALONE] != 0) {
-			output->print(",pauseStandalone: [");
-			output->print(copyHandlerTimesMin[TIMING_PAUSE_STANDALONE]);
-			output->print(',');
-			output->print(copyHandlerTimesMax[TIMING_PAUSE_STANDALONE]);
-			output->print(']');
-		}
-		if (copyHandlerTimesMax[TIMING_PAUSE_FOLLOWING] != 0) {
-			output->print(",pauseFollowing: [");
-			output->print(copyHandlerTimesMin[TIMING_PAUSE_FOLLOWING]);
-			output->print(',');
-			output->print(copyHandlerTimesMax[TIMING_PAUSE_FOLLOWING]);
-			output->print(']');
-		}
-		if (copyHandlerTimesMax[TIMING_HANDLER_ZERO] != 0) {
-			output->print(",zeroBit: [");
-			output->print(copyHandlerTimesMin[TIMING_HANDLER_ZERO]);
-			output->print(',');
-			output->print(copyHandlerTimesMax[TIMING_HANDLER_ZERO]);
-			output->print(']');
-		}
-		if (copyHandlerTimesMax[TIMING_HANDLER_ONE] != 0) {
-			output->print(",oneBit: [");
-			output->print(copyHandlerTimesMin[TIMING_HANDLER_ONE]);
-			output->print(',');
-			output->print(copyHandlerTimesMax[TIMING_HANDLER_ONE]);
-			output->print(']');
-		}
-		if (copyHandlerTimesMax[TIMING_SAMPLE_ZERO] != 0) {
-			output->print(",sampleZero: [");
-			output->print(copyHandlerTimesMin[TIMING_SAMPLE_ZERO]);
-			output->print(',');
-			output->print(copyHandlerTimesMax[TIMING_SAMPLE_ZERO]);
-			output->print(']');
-		}
-		if (copyHandlerTimesMax[TIMING_SAMPLE_ONE] != 0) {
-			output->print(",sampleOne: [");
-			output->print(copyHandlerTimesMin[TIMING_SAMPLE_ONE]);
-			output->print(',');
-			output->print(copyHandlerTimesMax[TIMING_SAMPLE_ONE]);
-			output->print(']');
-		}
-		if (copyHandlerTimesMax[TIMING_SAMPLE_COMPLETE] != 0) {
-			output->print(",sampleComplete: [");
-			output->print(copyHandlerTimesMin[TIMING_SAMPLE_COMPLETE]);
-			output->print(',');
-			output->print(copyHandlerTimesMax[TIMING_SAMPLE_COMPLETE]);
-			output->print(']');
-		}
-		if (copyHandlerTimesMax[TIMING_OTHER] != 0) {
-			output->print(",other: [");
-			output->print(copyHandlerTimesMin[TIMING_OTHER]);
-			output->print(',');
-			output->print(copyHandlerTimesMax[TIMING_OTHER]);
-			output->print(']');
-		}
-		output->println("}");
+		Histogram::printAll(output);
 #endif
-
-		return;
 	}
-
-	interrupts();
 }
+
+// Only the policies that are used, because each one has its own
+// statically allocated handler timing histograms (add any other
+// policies that are used here and to the Code::finalise() instantiations
+// in Code.cpp)
+template class BasicReceiver<RECEIVER_POLICY>;
+#ifdef DEBUG_TIMING
+template class BasicReceiver<DebugTimingReceiverPolicy>;
+#endif
@@ -22,65 +22,166 @@
 #include <limits.h>
 #include <Arduino.h>
 
+#include "Burst.hpp"
 #include "Code.hpp"
+#include "ReceiverPolicy.hpp"
 
-class Receiver {
+// Output timing statistics after every code and compare the
+// interrupt handler with a protocol specific policy
+//#define DEBUG_TIMING
+
+struct ReceiverTiming {
+	// Sampling
+	unsigned long sampleMinTime[2];
+	unsigned long sampleMaxTime[2];
+	bool sampleComplete;
+
+	// Timing
+	unsigned long bitTime[2];
+
+	// Glitch merging
+	unsigned long bitStart;
+	bool glitchable; // Previous pulse was a bit
+	bool invalid; // Previous pulse was not a bit
+
+	// Message
+	unsigned long start;
+};
+
+// Decoding of one code, with its own bit timing (the code is decoded
+// directly into one of the receiver's codes, which is queued as it is)
+struct ReceiverContext {
+	bool active = false;
+	uint8_t slot; // Index of the code in the receiver's codes
+	unsigned long last; // Start of the current pulse
+	ReceiverTiming data;
+};
+
+// Each receiver has its own input pin, decoder state and buffered codes.
+// Codes that are received at the same time by more than one receiver
+// are only output once.
+template <class Policy>
+class BasicReceiver: protected Policy {
 public:
-	Receiver();
-	virtual ~Receiver();
-	void attach(int pin);
-	void printCode(Print *output);
-
-	// All durations are specified as the numerator of a fractional number
-	// with the following denominator (divisor), which must be a power of 2
-	// or the calculations will take significantly longer
-	static constexpr unsigned long DIVISOR = 1 << 3;
-
-	// Relative duration compared to sampled bit periods
-	static constexpr unsigned long MIN_ZERO_DURATION = 4;
-	static constexpr unsigned long MAX_ZERO_DURATION = 12;
-	static constexpr unsigned long MIN_ONE_DURATION = 4;
-	static constexpr unsigned long MAX_ONE_DURATION = 12;
-
-	// Relative duration of the 1-bit compared to the 0-bit for a preamble
-	static constexpr unsigned long PREAMBLE_RELATIVE_DURATION = 64;
-
-	// Sample bits until at least this many (to get the best average duration)
-	static constexpr unsigned long MIN_SAMPLES = 8;
-	// Continue sampling until this many bits (if the 1-bit duration is still unknown)
-	static constexpr unsigned long MAX_SAMPLES = 32;
+	BasicReceiver();
+	virtual ~BasicReceiver();
+	// Without an interrupt the caller must call interruptHandler() for
+	// every change of the pin
+	void attach(int pin, bool interrupt = true);
+	void detach();
+	// Output the next code (and add it to a burst of repeats)
+	void printCode(Print *output, Burst *burst = nullptr);
+
+	// Decode the next code without outputting it (returns false if
+	// there is no code or it's not valid), for output elsewhere
+	bool decodeCode(Code &code);
+	static void printCode(Print *output, const Code &code);
+
+	void interruptHandler();
+	// A code is currently being received
+	bool isReceiving() const { return receiving; }
+	// Edges that were ignored because they were our own transmission
+	unsigned long suppressedEchoes() const { return echoes; }
+
+	// Maximum number of receivers (with the same policy) that can be attached
+	static constexpr unsigned int MAX_RECEIVERS = 3;
+
+	using Policy::DIVISOR;
+
+	using Policy::MIN_ZERO_DURATION;
+	using Policy::MAX_ZERO_DURATION;
+	using Policy::MIN_ONE_DURATION;
+	using Policy::MAX_ONE_DURATION;
+
+	using Policy::PREAMBLE_RELATIVE_DURATION;
+
+	using Policy::MIN_SAMPLES;
+	using Policy::MAX_SAMPLES;
 
 protected:
-	// Minimum relative size of a 1-bit compared to a 0-bit
-	static constexpr unsigned long MIN_RELATIVE_DURATION = 14;
+	using Policy::MIN_RELATIVE_DURATION;
 
-	// Relative duration compared to pre pause duration
-	static constexpr unsigned long MIN_POST_PAUSE_DURATION = 4;
-	static constexpr unsigned long MAX_POST_PAUSE_DURATION = 32;
+	using Policy::MIN_POST_PAUSE_DURATION;
+	using Policy::MAX_POST_PAUSE_DURATION;
 
-	// Minimum time for an initial pause or processing will be ignored
-	static constexpr unsigned long MIN_PAUSE_US = 4000;
+	using Policy::MIN_PAUSE_US;
 
-	// Minimum/maximum time for a bit or processing will abort
-	static constexpr unsigned long MIN_BIT_US = 100;
-	static constexpr unsigned long MAX_BIT_US = 5000;
+	using Policy::MIN_BIT_US;
+	using Policy::MAX_BIT_US;
 
-#ifdef TRACE_BITS
-	static constexpr unsigned int MAX_CODES = 2;
-#else
-	static constexpr unsigned int MAX_CODES = 16;
-#endif
+	using Policy::ECHO_US;
+
+	using Policy::MAX_GLITCHES;
+	using Policy::MAX_CONTEXTS;
+
+	using Policy::NOISE_PERIOD_US;
+	using Policy::MAX_NOISE_EDGES;
+	using Policy::FLOOD_NOISE_EDGES;
+	using Policy::FLOOD_PAUSE_STEP_US;
+	using Policy::FLOOD_MAX_PAUSE_US;
+
+	using Policy::MAX_CODES;
 
-	Code codes[MAX_CODES];
+	// Each code is either queued (in the order of the indexes in the
+	// queue) or being decoded by a context, so codes are never copied
+	// when they're received
+	Code codes[MAX_CODES + MAX_CONTEXTS];
+	uint8_t queue[MAX_CODES];
 	unsigned int codeReadIndex = 0;
 	unsigned int codeWriteIndex = 0;
 
 private:
-	static void interruptHandler();
+	// A code received recently, to identify duplicates from other receivers
+	struct RecentCode {
+		uint32_t hash; // Of the message
+		unsigned int messageLength;
+		unsigned long endTime;
+	};
+
+	// No code is using the overflow buffer
+	static constexpr uint8_t NO_SLOT = UINT8_MAX;
+	// Number of recent codes that are kept
+	static constexpr unsigned int RECENT_CODES = 4;
+
+	enum class EdgeResult : uint8_t {
+		CONTINUE,
+		FAILED,
+		COMPLETE,
+	};
+
+	template <unsigned int Index> static void interruptTrampoline();
 	static void addBit(Code *code, uint8_t bit, const unsigned long &duration);
+	static void removeBit(Code *code, const unsigned long &duration);
+	void startCode(unsigned long now, unsigned long duration, bool standalone);
+	bool extendCode(ReceiverContext &context);
+	EdgeResult processEdge(ReceiverContext &context, unsigned long now);
+	EdgeResult endCode(ReceiverContext &context, unsigned long end,
+		unsigned long duration, bool postPausePresent);
 	void addCode();
+	void updateNoise(unsigned long now);
+	bool dequeueCode(Code &code);
+	bool isDuplicate(const Code &code);
+
+	static void (*const TRAMPOLINES[MAX_RECEIVERS])();
+	static BasicReceiver *instances[MAX_RECEIVERS];
+
+	int pin = -1;
+	unsigned long last = 0;
+	bool receiving = false;
+	unsigned long minPauseTime = MIN_PAUSE_US;
+	unsigned long noiseStart = 0;
+	unsigned int noiseEdges = 0;
+	uint16_t noiseRate = 0;
+	unsigned long echoes = 0;
+	ReceiverContext contexts[MAX_CONTEXTS];
+	// Only one code at a time can be longer than a code's inline message
+	uint8_t overflow[Code::OVERFLOW_SIZE];
+	uint8_t overflowSlot = NO_SLOT; // Index of the code using the overflow buffer
+	RecentCode recent[RECENT_CODES] = {};
+	unsigned int recentIndex = 0; // Next recent code to replace
+	uint8_t timingType; // Path through the interrupt handler
 };
 
-extern Receiver receiver;
+typedef BasicReceiver<RECEIVER_POLICY> Receiver;
 
 #endif
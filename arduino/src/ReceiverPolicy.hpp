@@ -0,0 +1,180 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RF433_OOK_RECEIVERPOLICY_HPP
+#define RF433_OOK_RECEIVERPOLICY_HPP
+
+#include "Code.hpp"
+
+// Timing parameters can be overridden at build time (e.g. when
+// searching for the best values with host/sweep.py)
+#ifndef RECEIVER_MIN_ZERO_DURATION
+# define RECEIVER_MIN_ZERO_DURATION 4
+#endif
+#ifndef RECEIVER_MAX_ZERO_DURATION
+# define RECEIVER_MAX_ZERO_DURATION 12
+#endif
+#ifndef RECEIVER_MIN_ONE_DURATION
+# define RECEIVER_MIN_ONE_DURATION 4
+#endif
+#ifndef RECEIVER_MAX_ONE_DURATION
+# define RECEIVER_MAX_ONE_DURATION 12
+#endif
+#ifndef RECEIVER_PREAMBLE_RELATIVE_DURATION
+# define RECEIVER_PREAMBLE_RELATIVE_DURATION 64
+#endif
+#ifndef RECEIVER_MIN_SAMPLES
+# define RECEIVER_MIN_SAMPLES 8
+#endif
+#ifndef RECEIVER_MAX_SAMPLES
+# define RECEIVER_MAX_SAMPLES 32
+#endif
+#ifndef RECEIVER_MIN_RELATIVE_DURATION
+# define RECEIVER_MIN_RELATIVE_DURATION 14
+#endif
+#ifndef RECEIVER_MIN_PAUSE_US
+# define RECEIVER_MIN_PAUSE_US 4000
+#endif
+#ifndef RECEIVER_ECHO_US
+# define RECEIVER_ECHO_US 200
+#endif
+
+// Generic timing that works for any protocol with
+// 1-bits that are longer than 0-bits
+struct DefaultReceiverPolicy {
+	static const char *name() { return "default"; }
+
+	// All durations are specified as the numerator of a fractional number
+	// with the following denominator (divisor), which must be a power of 2
+	// or the calculations will take significantly longer
+	static constexpr unsigned long DIVISOR = 1 << 3;
+
+	// Relative duration compared to sampled bit periods
+	static constexpr unsigned long MIN_ZERO_DURATION = RECEIVER_MIN_ZERO_DURATION;
+	static constexpr unsigned long MAX_ZERO_DURATION = RECEIVER_MAX_ZERO_DURATION;
+	static constexpr unsigned long MIN_ONE_DURATION = RECEIVER_MIN_ONE_DURATION;
+	static constexpr unsigned long MAX_ONE_DURATION = RECEIVER_MAX_ONE_DURATION;
+
+	// Relative duration of the 1-bit compared to the 0-bit for a preamble
+	static constexpr unsigned long PREAMBLE_RELATIVE_DURATION = RECEIVER_PREAMBLE_RELATIVE_DURATION;
+
+	// Sample bits until at least this many (to get the best average duration)
+	static constexpr unsigned long MIN_SAMPLES = RECEIVER_MIN_SAMPLES;
+	// Continue sampling until this many bits (if the 1-bit duration is still unknown)
+	static constexpr unsigned long MAX_SAMPLES = RECEIVER_MAX_SAMPLES;
+
+	// Minimum relative size of a 1-bit compared to a 0-bit
+	static constexpr unsigned long MIN_RELATIVE_DURATION = RECEIVER_MIN_RELATIVE_DURATION;
+
+	// Relative duration compared to pre pause duration
+	static constexpr unsigned long MIN_POST_PAUSE_DURATION = 4;
+	static constexpr unsigned long MAX_POST_PAUSE_DURATION = 32;
+
+	// Minimum time for an initial pause or processing will be ignored
+	static constexpr unsigned long MIN_PAUSE_US = RECEIVER_MIN_PAUSE_US;
+
+	// Minimum/maximum time for a bit or processing will abort
+	static constexpr unsigned long MIN_BIT_US = 100;
+	static constexpr unsigned long MAX_BIT_US = 5000;
+
+	// Edges this soon after an edge of our own transmission are the echo
+	// of it (the delay of the receiver) and are ignored
+	static constexpr unsigned long ECHO_US = RECEIVER_ECHO_US;
+
+	// Maximum number of pulses shorter than MIN_BIT_US in a code that will
+	// be merged with the pulses either side of them (after sampling)
+	static constexpr unsigned int MAX_GLITCHES = 4;
+
+	// Number of codes that can be decoded at the same time, when a pause
+	// starts another code but it could also be a bit in an existing code
+#if defined(TRACE_BITS)
+	static constexpr unsigned int MAX_CONTEXTS = 1;
+#elif defined(ARDUINO_ARCH_AVR)
+	static constexpr unsigned int MAX_CONTEXTS = 2;
+#else
+	static constexpr unsigned int MAX_CONTEXTS = 3;
+#endif
+
+	// Edges shorter than MIN_BIT_US outside of a code are counted as noise
+	// over this period, which must be a power of 2
+	static constexpr unsigned long NOISE_PERIOD_US = 1UL << 16;
+	static constexpr unsigned int MAX_NOISE_EDGES = 4095;
+
+	// When there's at least this much noise in a period (receiver AGC
+	// chatter while nothing is transmitting) the minimum initial pause is
+	// raised by a step each period, up to a maximum, so that fewer noise
+	// pulses look like the start of a code. It's lowered again by a step
+	// for each period without noise. The maximum has to be less than the
+	// shortest pause of a supported protocol (HomeEasyV0, 4932µs).
+	static constexpr unsigned int FLOOD_NOISE_EDGES = 64;
+	static constexpr unsigned long FLOOD_PAUSE_STEP_US = 200;
+	static constexpr unsigned long FLOOD_MAX_PAUSE_US = 4800;
+
+	// Number of received codes that can be buffered
+#ifdef TRACE_BITS
+	static constexpr unsigned int MAX_CODES = 2;
+#else
+	static constexpr unsigned int MAX_CODES = 16;
+#endif
+};
+
+// HomeEasy V0-V3 remotes have 1-bits that are at least 3 times longer
+// than 0-bits and no bits or preambles longer than 2.6ms, so every
+// relative duration can be a power of 2 (shifts only)
+struct HomeEasyReceiverPolicy: DefaultReceiverPolicy {
+	static const char *name() { return "HomeEasy"; }
+
+	static constexpr unsigned long MIN_ZERO_DURATION = 4;
+	static constexpr unsigned long MAX_ZERO_DURATION = 16;
+	static constexpr unsigned long MIN_ONE_DURATION = 4;
+	static constexpr unsigned long MAX_ONE_DURATION = 16;
+
+	static constexpr unsigned long MIN_RELATIVE_DURATION = 16;
+
+	static constexpr unsigned long MAX_BIT_US = 3000;
+};
+
+// Comparison of the interrupt handler timing for HomeEasy codes against
+// the generic policy, without using as much memory for a second receiver
+struct DebugTimingReceiverPolicy: HomeEasyReceiverPolicy {
+	static const char *name() { return "HomeEasy (comparison)"; }
+
+	static constexpr unsigned int MAX_CODES = 2;
+};
+
+// Policy used by the receiver, this can be changed for each board
+// by adding -DRECEIVER_POLICY=... to its build_flags
+#ifndef RECEIVER_POLICY
+# define RECEIVER_POLICY DefaultReceiverPolicy
+#endif
+
+static constexpr unsigned long relativeDurationGCD(unsigned long a, unsigned long b) {
+	return b == 0 ? a : relativeDurationGCD(b, a % b);
+}
+
+// Multiply a duration by a relative duration (a fraction of DIVISOR)
+//
+// The fraction is reduced at compile time so that a power of 2 relative
+// duration is a single shift and there's no multiplication at all
+template <class Policy, unsigned long Numerator>
+static inline unsigned long relativeDuration(unsigned long value) {
+	return value * (Numerator / relativeDurationGCD(Numerator, Policy::DIVISOR))
+		/ (Policy::DIVISOR / relativeDurationGCD(Numerator, Policy::DIVISOR));
+}
+
+#endif
@@ -0,0 +1,55 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RF433_OOK_TRANSMIT_SCHEDULE_HPP
+#define RF433_OOK_TRANSMIT_SCHEDULE_HPP
+
+#include <Arduino.h>
+
+// Times of the edges in our own transmission, so that receivers can
+// ignore the echo of it instead of decoding it (and spending time in
+// interrupt handlers while the transmitter is waiting for edges)
+class TransmitSchedule {
+public:
+	static inline void start(unsigned long now) {
+		lastEdge = now;
+		active = true;
+	}
+
+	// Interrupts must be disabled (or the receiver could see the
+	// output change before the time of the edge)
+	static inline void edge(unsigned long now) {
+		lastEdge = now;
+	}
+
+	static inline void stop() {
+		active = false;
+	}
+
+	// An edge at this time is within the window of receiver delay
+	// after one of our own edges
+	static inline bool isEcho(unsigned long now, unsigned long window) {
+		return active && now - lastEdge < window;
+	}
+
+private:
+	static volatile bool active;
+	static volatile unsigned long lastEdge;
+};
+
+#endif
@@ -17,10 +17,12 @@
  *
  */
 
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "Transmitter.hpp"
+#include "TransmitSchedule.hpp"
 
 const Transmitter::Preset Transmitter::PRESETS[] = {
 	{ /*  4932 */ 3960, {             0,               0 }, { /* 312 */ 308, /*  968 */  956 }, 5 }, //< HomeEasyV0
@@ -29,6 +31,8 @@ const Transmitter::Preset Transmitter::PRESETS[] = {
 	{ /* 10212 */ 8912, { /* 216 */ 172, /* 2560 */ 2582 }, { /* 240 */ 220, /* 1300 */ 1304 }, 5 }, //< HomeEasyV3
 };
 
+const unsigned int Transmitter::PRESET_COUNT = sizeof(PRESETS) / sizeof(PRESETS[0]);
+
 Transmitter::Transmitter(int pin, bool silent) {
 	this->pin = pin;
 	this->silent = silent;
@@ -38,9 +42,17 @@ Transmitter::~Transmitter() {
 
 }
 
-void Transmitter::init() const {
+void Transmitter::init() {
 	pinMode(pin, OUTPUT);
+	// Also turns off PWM on AVR
 	digitalWrite(pin, LOW);
+
+#if defined(TRANSMITTER_DIRECT_SIO) || defined(TRANSMITTER_DIRECT_GPIO)
+	outputMask = 1UL << pin;
+#elif defined(TRANSMITTER_DIRECT_PORT)
+	outputRegister = portOutputRegister(digitalPinToPort(pin));
+	outputMask = digitalPinToBitMask(pin);
+#endif
 }
 
 void Transmitter::processInput(Stream *console) {
@@ -79,6 +91,10 @@ void Transmitter::processLine(Print *output) {
 			parse = nullptr) {
 		if (token[0] == '?') {
 			configured = true;
+		} else if (token[0] == '~') {
+			calibrate(output);
+		} else if (token[0] == '!') {
+			Histogram::printAll(output);
 		} else if (strlen(token) > 2 && token[1] == '=') {
 			char *endptr = nullptr;
 			unsigned long value = strtoul(&token[2], &endptr, 10);
@@ -145,8 +161,15 @@ void Transmitter::processLine(Print *output) {
 				}
 				break;
 
+			case 'E': // edge adjustment
+				if (value <= MAX_EDGE_ADJUST_US) {
+					edgeAdjust = value;
+					configured = true;
+				}
+				break;
+
 			case 'S': // preset
-				if (value < sizeof(PRESETS) / sizeof(PRESETS[0])) {
+				if (value < PRESET_COUNT) {
 					prePauseTime = interPauseTime = postPauseTime = PRESETS[value].pauseTime;
 					preambleTime[0] = PRESETS[value].preambleTime[0];
 					preambleTime[1] = PRESETS[value].preambleTime[1];
@@ -158,7 +181,7 @@ void Transmitter::processLine(Print *output) {
 				break;
 			}
 		} else {
-			Code code(token);
+			Code code(token, overflow);
 
 			if (configured) {
 				outputConfiguration(output);
@@ -200,13 +223,107 @@ void Transmitter::outputConfiguration(Print *output) {
 		output->print(bitTime[1]);
 		output->print(",repeat: ");
 		output->print(repeat);
+		output->print(",edgeAdjust: ");
+		output->print(edgeAdjust);
 		output->println('}');
 	}
 }
 
+// Measure the error in the length of pulses without any adjustment and
+// then use the average error as the adjustment
+void Transmitter::calibrate(Print *output) {
+	const Code code(CALIBRATION_CODE);
+	PulseErrors before;
+	PulseErrors after;
+	unsigned long tick;
+	unsigned long next;
+	unsigned long resolution = 0;
+
+	// Wait for two ticks of micros() to find its resolution (it doesn't
+	// advance by itself on the host unless it has a clock model)
+	tick = microsTick(micros());
+	next = microsTick(tick);
+	if (tick != next) {
+		resolution = next - tick;
+	}
+
+	microsTickMask = (resolution && !(resolution & (resolution - 1))) ? resolution - 1 : 0;
+
+	edgeAdjust = 0;
+	measure(code, before);
+
+	if (before.count && before.total > 0) {
+		edgeAdjust = (before.total + before.count / 2) / before.count;
+		if (edgeAdjust > MAX_EDGE_ADJUST_US) {
+			edgeAdjust = MAX_EDGE_ADJUST_US;
+		}
+	}
+
+	measure(code, after);
+
+	// Don't keep an adjustment that made the pulses worse
+	if (edgeAdjust && after.squares > before.squares) {
+		edgeAdjust = 0;
+	}
+
+	if (!silent) {
+		output->print("calibrate: {microsResolution: ");
+		output->print(resolution);
+		output->print(",before: ");
+		printErrors(output, before);
+		output->print(",edgeAdjust: ");
+		output->print(edgeAdjust);
+		output->print(",after: ");
+		printErrors(output, after);
+		output->println('}');
+	}
+}
+
+// Wait for micros() to change from a value (returning the same value if it
+// doesn't change)
+unsigned long Transmitter::microsTick(unsigned long tick) {
+	for (unsigned long i = 0; i < MAX_RESOLUTION_POLLS; i++) {
+		const unsigned long now = micros();
+
+		if (now != tick) {
+			return now;
+		}
+	}
+
+	return tick;
+}
+
+void Transmitter::measure(const Code &code, PulseErrors &errors) {
+	errors.total = 0;
+	errors.squares = 0;
+	errors.min = LONG_MAX;
+	errors.max = LONG_MIN;
+	errors.count = 0;
+
+	measuring = &errors;
+	transmit(code);
+	measuring = nullptr;
+}
+
+void Transmitter::printErrors(Print *output, const PulseErrors &errors) {
+	output->print("{pulses: ");
+	output->print(errors.count);
+	if (errors.count) {
+		output->print(",mean: ");
+		output->print(errors.total / (long)errors.count);
+		output->print(",min: ");
+		output->print(errors.min);
+		output->print(",max: ");
+		output->print(errors.max);
+	}
+	output->print('}');
+}
+
 void Transmitter::transmit(const Code &code) {
 	state = LOW;
 	start = micros();
+	totalError = 0;
+	TransmitSchedule::start(start);
 
 	pausePin(prePauseTime);
 
@@ -228,19 +345,99 @@ void Transmitter::transmit(const Code &code) {
 	}
 
 	pausePin(postPauseTime);
+	TransmitSchedule::stop();
+}
+
+unsigned long Transmitter::airtime(const Code &code) const {
+	unsigned long bits = 0;
+
+	for (unsigned int i = 0; i < code.messageLength; i++) {
+		uint8_t bit = code.message[i / 8] & (0x80 >> (i & 0x7)) ? 1 : 0;
+
+		bits += bitTime[bit];
+	}
+
+	return prePauseTime + (repeat - 1) * (unsigned long)interPauseTime + postPauseTime
+		+ repeat * (preambleTime[0] + preambleTime[1] + bits);
+}
+
+// Interrupts must be disabled (for the port register)
+inline void Transmitter::writePin(uint8_t value) {
+#if defined(TRANSMITTER_DIRECT_SIO)
+	if (value) {
+		sio_hw->gpio_set = outputMask;
+	} else {
+		sio_hw->gpio_clr = outputMask;
+	}
+#elif defined(TRANSMITTER_DIRECT_GPIO)
+	REG_WRITE(value ? GPIO_OUT_W1TS_REG : GPIO_OUT_W1TC_REG, outputMask);
+#elif defined(TRANSMITTER_DIRECT_PORT)
+	if (value) {
+		*outputRegister |= outputMask;
+	} else {
+		*outputRegister &= ~outputMask;
+	}
+#else
+	digitalWrite(pin, value);
+#endif
+}
+
+// Wait until the end of the pulse that started at the start time, ending
+// early by the edge adjustment
+//
+// When micros() has a resolution of more than 1µs the delay can only end
+// on one of its ticks, so an adjustment that's less than that has no
+// effect. When the total error in the pulses so far is at least a tick
+// the pulse ends one tick early, so that the average is correct without
+// making any pulse more than a tick shorter.
+inline void Transmitter::delayPulse(unsigned long duration) {
+	long adjust = edgeAdjust;
+
+	if (microsTickMask && totalError > (long)microsTickMask) {
+		adjust += microsTickMask + 1;
+	}
+
+	if (adjust < 0) {
+		adjust = 0;
+	}
+
+	if (duration > (unsigned long)adjust) {
+		while (micros() - start < duration - adjust) {
+			// Delay
+		}
+	}
 }
 
 inline void Transmitter::togglePin(unsigned long duration) {
+	unsigned long now;
+
 	noInterrupts();
-	start = micros();
-	digitalWrite(pin, state);
+	now = micros();
+	writePin(state);
+	TransmitSchedule::edge(now);
 	interrupts();
 
-	if (duration) {
-		while (micros() - start < duration) {
-			// Delay
+	// The previous pulse was expected to end at the start time
+	const long error = (long)(now - start);
+
+	edgeErrors.add(error < 0 ? -error : error);
+	if (measuring != nullptr) {
+		measuring->total += error;
+		measuring->squares += (unsigned long)(error * error);
+		if (error < measuring->min) {
+			measuring->min = error;
+		}
+		if (error > measuring->max) {
+			measuring->max = error;
 		}
+		measuring->count++;
 	}
+	if (microsTickMask && labs(totalError + error) <= (long)MAX_EDGE_ADJUST_US) {
+		totalError += error;
+	}
+	start = now;
+
+	delayPulse(duration);
 
 	state = (state == LOW) ? HIGH : LOW;
 	start += duration;
@@ -248,13 +445,13 @@ inline void Transmitter::togglePin(unsigned long duration) {
 
 inline void Transmitter::pausePin(unsigned long duration) {
 	// start has already been set
-	digitalWrite(pin, LOW);
+	noInterrupts();
+	writePin(LOW);
+	// This is an edge when the code has an odd number of bits
+	TransmitSchedule::edge(micros());
+	interrupts();
 
-	if (duration) {
-		while (micros() - start < duration) {
-			// Delay
-		}
-	}
+	delayPulse(duration);
 
 	state = HIGH;
 	start += duration;
@@ -23,15 +23,51 @@
 #include <Arduino.h>
 
 #include "Code.hpp"
+#include "Histogram.hpp"
+
+// Use digitalWrite() instead of writing directly to the output register
+//#define TRANSMITTER_DIGITAL_WRITE
+
+#if !defined(TRANSMITTER_DIGITAL_WRITE)
+# if defined(ARDUINO_ARCH_RP2040)
+#  include <hardware/structs/sio.h>
+#  define TRANSMITTER_DIRECT_SIO
+# elif defined(ARDUINO_ARCH_ESP32)
+#  include <soc/gpio_reg.h>
+#  include <soc/soc.h>
+#  define TRANSMITTER_DIRECT_GPIO
+# elif defined(ARDUINO_ARCH_AVR) || defined(HOST_PORT_REGISTERS)
+#  define TRANSMITTER_DIRECT_PORT
+# endif
+#endif
+
+// Time (µs) to end each pulse early to allow for the time taken to
+// change the output, which depends on the board (the "~" command
+// measures it from micros() but not the edges that are transmitted)
+#ifndef TRANSMITTER_EDGE_ADJUST_US
+# define TRANSMITTER_EDGE_ADJUST_US 0
+#endif
+
+// Resolution of micros() (µs), which must be a power of 2 ("~" also
+// measures this)
+#ifndef TRANSMITTER_MICROS_RESOLUTION_US
+# if defined(ARDUINO_ARCH_AVR) && defined(F_CPU)
+#  define TRANSMITTER_MICROS_RESOLUTION_US (64000000UL / F_CPU)
+# else
+#  define TRANSMITTER_MICROS_RESOLUTION_US 1
+# endif
+#endif
 
 class Transmitter {
 public:
 	Transmitter(int pin, bool silent);
 	virtual ~Transmitter();
-	void init() const;
+	void init();
 	void processInput(Stream *console);
+	// Time (µs) that it takes to transmit a code with the current
+	// configuration, including the pauses
+	unsigned long airtime(const Code &code) const;
 
-protected:
 	struct Preset {
 		unsigned int pauseTime;
 		unsigned int preambleTime[2];
@@ -39,25 +75,51 @@ protected:
 		unsigned int repeat;
 	};
 
-	static constexpr uint8_t MAX_LENGTH = 100;
+	static const Preset PRESETS[];
+	static const unsigned int PRESET_COUNT;
+
+protected:
+	// Room for a full length code and its configuration
+	static constexpr unsigned int MAX_LENGTH = (Code::MAX_LENGTH + 2) / 4 + 52;
 	static constexpr unsigned long MAX_PREAMBLE_US = 10000;
 	static constexpr unsigned long MAX_BIT_US = 5000;
 	static constexpr unsigned long MAX_PAUSE_US = 50000;
 	static constexpr unsigned long MAX_REPEAT = 100;
-
-	static const Preset PRESETS[];
+	static constexpr unsigned long MAX_EDGE_ADJUST_US = 100;
+	// Maximum number of calls to micros() waiting for it to change when
+	// measuring its resolution
+	static constexpr unsigned long MAX_RESOLUTION_POLLS = 10000;
+	// Alternating short and long pulses
+	static constexpr const char *CALIBRATION_CODE = "5555555555555555";
 
 	void processLine(Print *output);
 	void outputConfiguration(Print *output);
-	void transmit(const Code &code);
+	void calibrate(Print *output);
+	virtual void transmit(const Code &code);
 	void togglePin(unsigned long duration);
 	void pausePin(unsigned long duration);
+	void delayPulse(unsigned long duration);
+	unsigned long microsTick(unsigned long tick);
+	void writePin(uint8_t value);
 
 	char buffer[MAX_LENGTH + 1] = { 0 };
-	uint8_t length = 0;
+	unsigned int length = 0;
 	bool valid = true;
+	uint8_t overflow[Code::OVERFLOW_SIZE]; // For a long code
 
 	int pin;
+#if defined(TRANSMITTER_DIRECT_SIO) || defined(TRANSMITTER_DIRECT_GPIO)
+	uint32_t outputMask;
+#elif defined(TRANSMITTER_DIRECT_PORT)
+# if defined(HOST_PORT_REGISTERS)
+	typedef host::PortRegister PortRegister;
+# else
+	typedef volatile uint8_t PortRegister;
+# endif
+	// Output register and bit of the pin
+	PortRegister *outputRegister;
+	uint8_t outputMask;
+#endif
 	bool silent;
 	unsigned int prePauseTime = 10000;
 	unsigned int interPauseTime = 10000;
@@ -65,10 +127,27 @@ protected:
 	unsigned int preambleTime[2] = { 0, 0 };
 	unsigned int bitTime[2] = { 300, 900 };
 	unsigned int repeat = 5;
+	unsigned int edgeAdjust = TRANSMITTER_EDGE_ADJUST_US;
+	unsigned long microsTickMask = TRANSMITTER_MICROS_RESOLUTION_US - 1;
 
 private:
+	// Error in the length of pulses (µs)
+	struct PulseErrors {
+		long total;
+		unsigned long squares; // Total of the squared errors
+		long min;
+		long max;
+		unsigned int count;
+	};
+
+	void measure(const Code &code, PulseErrors &errors);
+	static void printErrors(Print *output, const PulseErrors &errors);
+
 	uint8_t state;
-	unsigned long start;
+	unsigned long start; // Time of the next edge
+	long totalError = 0; // Error in the length of the pulses so far
+	PulseErrors *measuring = nullptr;
+	Histogram edgeErrors{"transmitter", "edgeError"}; // Error in the length of each pulse
 };
 
 #endif
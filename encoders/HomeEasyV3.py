@@ -51,7 +51,7 @@ if __name__ == "__main__":
 	elif args.server:
 		s = socket.socket(socket.AF_UNIX, socket.SOCK_SEQPACKET)
 		s.connect(args.server)
-		s.write(code + "\n")
+		s.send(code.encode("utf-8") + b"\n")
 		s.close()
 	else:
 		print(code)
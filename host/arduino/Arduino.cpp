@@ -0,0 +1,383 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+
+#include <map>
+
+#include "Arduino.h"
+#include "Host.hpp"
+
+static constexpr int MAX_PINS = 64;
+
+static unsigned long clockMicros = 0;
+static int pinValues[MAX_PINS] = { 0 };
+static void (*pinHandlers[MAX_PINS])() = { nullptr };
+
+static host::ClockModel clockModel = {};
+static unsigned long clockNanos = 0;
+static unsigned long nextInterrupt = 0;
+static bool interruptsEnabled = true;
+static uint64_t interruptsDisabledTime = 0;
+static unsigned long interruptsDisabledMax = 0;
+static int recordPin = -1;
+static std::vector<uint64_t> *recordTimes = nullptr;
+
+// Changes to input pins that happen while other code is running, from
+// either the scheduled input or the echo of an output
+enum InputSource { INPUT_SCHEDULED, INPUT_ECHO, LEN_INPUT };
+
+struct InputChange {
+	int pin;
+	InputSource source;
+	int value;
+};
+
+static std::multimap<unsigned long, InputChange> inputChanges;
+static int inputValues[MAX_PINS][LEN_INPUT] = { { 0 } };
+static bool deliveringInputs = false;
+static int echoOutputPin = -1;
+static int echoInputPin = -1;
+static unsigned long echoDelay = 0;
+
+static void deliverInputs();
+
+HostSerial Serial;
+
+// Time taken by a function (ns)
+static void spend(unsigned long cost) {
+	if (!cost) {
+		return;
+	}
+
+	clockNanos += cost;
+	clockMicros += clockNanos / 1000;
+	clockNanos %= 1000;
+
+	if (clockModel.interruptPeriod && (long)(clockMicros - nextInterrupt) >= 0) {
+		nextInterrupt = clockMicros + clockModel.interruptPeriod;
+		spend(clockModel.interruptCost);
+	}
+
+	deliverInputs();
+}
+
+unsigned long micros() {
+	unsigned long now = clockMicros;
+
+	spend(clockModel.microsCost);
+	if (clockModel.resolution > 1) {
+		now -= now % clockModel.resolution;
+	}
+	return now;
+}
+
+unsigned long millis() {
+	return clockMicros / 1000;
+}
+
+void pinMode(int pin, int mode) {
+	(void)pin;
+	(void)mode;
+}
+
+static uint64_t nanos() {
+	return (uint64_t)clockMicros * 1000 + clockNanos;
+}
+
+static void setPin(int pin, int value) {
+	if (pin >= 0 && pin < MAX_PINS) {
+		if (pin == recordPin && pinValues[pin] != value) {
+			recordTimes->push_back(nanos());
+		}
+		if (pin == echoOutputPin && pinValues[pin] != value) {
+			inputChanges.insert({ clockMicros + echoDelay, { echoInputPin, INPUT_ECHO, value } });
+		}
+		pinValues[pin] = value;
+	}
+}
+
+void digitalWrite(int pin, int value) {
+	setPin(pin, value);
+	spend(clockModel.writeCost);
+}
+
+namespace host {
+
+PortRegister &PortRegister::operator|=(uint8_t mask) {
+	for (int bit = 0; bit < 8; bit++) {
+		if (mask & (1 << bit)) {
+			setPin(port * 8 + bit, HIGH);
+		}
+	}
+	spend(clockModel.portWriteCost);
+	return *this;
+}
+
+PortRegister &PortRegister::operator&=(uint8_t mask) {
+	for (int bit = 0; bit < 8; bit++) {
+		if (!(mask & (1 << bit))) {
+			setPin(port * 8 + bit, LOW);
+		}
+	}
+	spend(clockModel.portWriteCost);
+	return *this;
+}
+
+} // namespace host
+
+static host::PortRegister ports[MAX_PINS / 8] = {
+	host::PortRegister(0), host::PortRegister(1), host::PortRegister(2), host::PortRegister(3),
+	host::PortRegister(4), host::PortRegister(5), host::PortRegister(6), host::PortRegister(7),
+};
+
+host::PortRegister *portOutputRegister(uint8_t port) {
+	return port < MAX_PINS / 8 ? &ports[port] : nullptr;
+}
+
+int digitalRead(int pin) {
+	return (pin >= 0 && pin < MAX_PINS) ? pinValues[pin] : LOW;
+}
+
+void attachInterrupt(int interrupt, void (*handler)(), int mode) {
+	(void)mode;
+
+	if (interrupt >= 0 && interrupt < MAX_PINS) {
+		pinHandlers[interrupt] = handler;
+	}
+}
+
+void detachInterrupt(int interrupt) {
+	if (interrupt >= 0 && interrupt < MAX_PINS) {
+		pinHandlers[interrupt] = nullptr;
+	}
+}
+
+void noInterrupts() {
+	if (interruptsEnabled) {
+		interruptsEnabled = false;
+		interruptsDisabledTime = nanos();
+	}
+}
+
+void interrupts() {
+	if (!interruptsEnabled) {
+		const unsigned long duration = nanos() - interruptsDisabledTime;
+
+		if (duration > interruptsDisabledMax) {
+			interruptsDisabledMax = duration;
+		}
+		interruptsEnabled = true;
+		deliverInputs();
+	}
+}
+
+// Call the interrupt handler for input changes that should have happened
+// by now (the carrier is on if it's on from either source)
+static void deliverInputs() {
+	if (deliveringInputs || !interruptsEnabled) {
+		return;
+	}
+
+	deliveringInputs = true;
+
+	while (!inputChanges.empty() && (long)(clockMicros - inputChanges.begin()->first) >= 0) {
+		const InputChange change = inputChanges.begin()->second;
+		int *values = inputValues[change.pin];
+
+		inputChanges.erase(inputChanges.begin());
+		values[change.source] = change.value;
+
+		const int value = (values[INPUT_SCHEDULED] || values[INPUT_ECHO]) ? HIGH : LOW;
+
+		if (pinValues[change.pin] != value) {
+			pinValues[change.pin] = value;
+
+			if (pinHandlers[change.pin] != nullptr) {
+				noInterrupts();
+				spend(clockModel.interruptCost);
+				pinHandlers[change.pin]();
+				interrupts();
+			}
+		}
+	}
+
+	deliveringInputs = false;
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+	size_t n = 0;
+
+	while (size--) {
+		n += write(*buffer++);
+	}
+	return n;
+}
+
+size_t Print::print(const char *value) {
+	return write((const uint8_t *)value, strlen(value));
+}
+
+size_t Print::print(const String &value) {
+	return write((const uint8_t *)value.c_str(), value.length());
+}
+
+size_t Print::print(char value) {
+	return write((uint8_t)value);
+}
+
+size_t Print::print(unsigned char value, int base) {
+	return print((unsigned long long)value, base);
+}
+
+size_t Print::print(int value, int base) {
+	return print((long long)value, base);
+}
+
+size_t Print::print(unsigned int value, int base) {
+	return print((unsigned long long)value, base);
+}
+
+size_t Print::print(long value, int base) {
+	return print((long long)value, base);
+}
+
+size_t Print::print(unsigned long value, int base) {
+	return print((unsigned long long)value, base);
+}
+
+size_t Print::print(long long value, int base) {
+	if (value < 0 && base == DEC) {
+		return print('-') + print((unsigned long long)-value, base);
+	}
+	return print((unsigned long long)value, base);
+}
+
+size_t Print::print(unsigned long long value, int base) {
+	char buffer[sizeof(value) * 8 + 1];
+
+	snprintf(buffer, sizeof(buffer), base == HEX ? "%llX" : "%llu", value);
+	return print(buffer);
+}
+
+size_t Print::print(const Printable &value) {
+	return value.printTo(*this);
+}
+
+size_t Print::println() {
+	return print("\r\n");
+}
+
+void HostSerial::begin(unsigned long baud) {
+	(void)baud;
+}
+
+size_t HostSerial::write(uint8_t c) {
+	return fwrite(&c, 1, 1, stdout);
+}
+
+size_t HostSerial::write(const uint8_t *buffer, size_t size) {
+	return fwrite(buffer, 1, size, stdout);
+}
+
+int HostSerial::available() {
+	return peek() >= 0 ? 1 : 0;
+}
+
+int HostSerial::read() {
+	int c = peek();
+
+	next = -2;
+	return c;
+}
+
+int HostSerial::peek() {
+	if (next == -2) {
+		next = getchar();
+		if (next == EOF) {
+			next = -1;
+		}
+	}
+	return next;
+}
+
+namespace host {
+
+void setMicros(unsigned long now) {
+	clockMicros = now;
+	clockNanos = 0;
+	nextInterrupt = now + clockModel.interruptPeriod;
+}
+
+void setClockModel(const ClockModel &model) {
+	clockModel = model;
+	nextInterrupt = clockMicros + clockModel.interruptPeriod;
+}
+
+unsigned long maxInterruptsDisabled() {
+	const unsigned long value = interruptsDisabledMax;
+
+	interruptsDisabledMax = 0;
+	return value;
+}
+
+void recordOutput(int pin, std::vector<uint64_t> *times) {
+	recordPin = times != nullptr ? pin : -1;
+	recordTimes = times;
+}
+
+void advanceMicros(unsigned long duration) {
+	clockMicros += duration;
+	deliverInputs();
+}
+
+void scheduleInput(int pin, unsigned long time, int value) {
+	if (pin >= 0 && pin < MAX_PINS) {
+		inputChanges.insert({ time, { pin, INPUT_SCHEDULED, value } });
+	}
+}
+
+void echoOutput(int outputPin, int inputPin, unsigned long delay) {
+	echoOutputPin = (inputPin >= 0 && inputPin < MAX_PINS) ? outputPin : -1;
+	echoInputPin = inputPin;
+	echoDelay = delay;
+}
+
+void edge(int pin, unsigned long duration) {
+	clockMicros += duration;
+
+	if (pin >= 0 && pin < MAX_PINS) {
+		pinValues[pin] = !pinValues[pin];
+
+		if (pinHandlers[pin] != nullptr) {
+			pinHandlers[pin]();
+		}
+	}
+}
+
+size_t StringPrint::write(uint8_t c) {
+	value += (char)c;
+	return 1;
+}
+
+size_t StringPrint::write(const uint8_t *buffer, size_t size) {
+	value.append((const char *)buffer, size);
+	return size;
+}
+
+} // namespace host
@@ -0,0 +1,190 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Minimal Arduino API for building the firmware sources on the host.
+ * Time is simulated and interrupts are raised explicitly (see Host.hpp).
+ */
+
+#ifndef RF433_OOK_HOST_ARDUINO_H
+#define RF433_OOK_HOST_ARDUINO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+#define HOST_BUILD
+
+#define LOW 0
+#define HIGH 1
+
+#define INPUT 0
+#define OUTPUT 1
+
+#define CHANGE 1
+
+#define DEC 10
+#define HEX 16
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+unsigned long micros();
+unsigned long millis();
+
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+int digitalRead(int pin);
+
+static inline int digitalPinToInterrupt(int pin) { return pin; }
+// Direct access to output pins in ports of 8 (like AVR)
+#define HOST_PORT_REGISTERS
+
+namespace host {
+
+class PortRegister {
+public:
+	explicit PortRegister(uint8_t port) : port(port) {}
+	PortRegister &operator|=(uint8_t mask);
+	PortRegister &operator&=(uint8_t mask);
+
+private:
+	uint8_t port;
+};
+
+} // namespace host
+
+static inline uint8_t digitalPinToPort(int pin) { return pin / 8; }
+static inline uint8_t digitalPinToBitMask(int pin) { return 1 << (pin % 8); }
+host::PortRegister *portOutputRegister(uint8_t port);
+
+void attachInterrupt(int interrupt, void (*handler)(), int mode);
+void detachInterrupt(int interrupt);
+void noInterrupts();
+void interrupts();
+
+class String {
+public:
+	String() {}
+	String(const char *value) : value(value) {}
+	String(const std::string &value) : value(value) {}
+	explicit String(char c) : value(1, c) {}
+
+	unsigned int length() const { return value.length(); }
+	unsigned char reserve(unsigned int size) { value.reserve(size); return 1; }
+	const char *c_str() const { return value.c_str(); }
+	const char *begin() const { return value.data(); }
+	const char *end() const { return value.data() + value.length(); }
+
+	char operator[](unsigned int index) const { return index < value.length() ? value[index] : 0; }
+	String &operator+=(const String &rhs) { value += rhs.value; return *this; }
+	String &operator+=(const char *rhs) { value += rhs; return *this; }
+	String &operator+=(char rhs) { value += rhs; return *this; }
+	bool operator==(const String &rhs) const { return value == rhs.value; }
+	bool operator==(const char *rhs) const { return value == rhs; }
+	bool operator!=(const String &rhs) const { return value != rhs.value; }
+	bool operator!=(const char *rhs) const { return value != rhs; }
+
+	int indexOf(char c) const {
+		size_t pos = value.find(c);
+		return pos == std::string::npos ? -1 : (int)pos;
+	}
+
+	String substring(unsigned int from) const { return substring(from, value.length()); }
+	String substring(unsigned int from, unsigned int to) const {
+		if (from > value.length()) {
+			return String();
+		}
+		return String(value.substr(from, to > from ? to - from : 0));
+	}
+
+	void remove(unsigned int index) {
+		if (index < value.length()) {
+			value.erase(index);
+		}
+	}
+
+private:
+	std::string value;
+};
+
+static inline String operator+(const char *lhs, const String &rhs) {
+	String tmp(lhs);
+	tmp += rhs;
+	return tmp;
+}
+
+class Print;
+
+class Printable {
+public:
+	virtual ~Printable() {}
+	virtual size_t printTo(Print &p) const = 0;
+};
+
+class Print {
+public:
+	virtual ~Print() {}
+	virtual size_t write(uint8_t c) = 0;
+	virtual size_t write(const uint8_t *buffer, size_t size);
+	virtual void flush() {}
+
+	size_t print(const char *value);
+	size_t print(const String &value);
+	size_t print(char value);
+	size_t print(unsigned char value, int base = DEC);
+	size_t print(int value, int base = DEC);
+	size_t print(unsigned int value, int base = DEC);
+	size_t print(long value, int base = DEC);
+	size_t print(unsigned long value, int base = DEC);
+	size_t print(long long value, int base = DEC);
+	size_t print(unsigned long long value, int base = DEC);
+	size_t print(const Printable &value);
+
+	size_t println();
+	template <typename T> size_t println(const T &value) { return print(value) + println(); }
+	template <typename T> size_t println(const T &value, int base) { return print(value, base) + println(); }
+};
+
+class Stream: public Print {
+public:
+	virtual int available() = 0;
+	virtual int read() = 0;
+	virtual int peek() = 0;
+};
+
+// Standard input/output
+class HostSerial: public Stream {
+public:
+	void begin(unsigned long baud);
+	operator bool() const { return true; }
+
+	virtual size_t write(uint8_t c) override;
+	virtual size_t write(const uint8_t *buffer, size_t size) override;
+	virtual int available() override;
+	virtual int read() override;
+	virtual int peek() override;
+
+private:
+	int next = -2;
+};
+
+extern HostSerial Serial;
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RF433_OOK_HOST_HPP
+#define RF433_OOK_HOST_HPP
+
+#include <Arduino.h>
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace host {
+
+// Simulated time, the clock only moves when it is told to
+void setMicros(unsigned long now);
+void advanceMicros(unsigned long duration);
+
+// Time taken by micros() and digitalWrite() so that code that waits for
+// the clock can run (by default the clock only moves when it is told to)
+struct ClockModel {
+	unsigned long resolution; // µs
+	unsigned long microsCost; // ns
+	unsigned long writeCost; // ns (digitalWrite)
+	unsigned long portWriteCost; // ns
+	unsigned long interruptPeriod; // µs
+	unsigned long interruptCost; // ns
+};
+
+void setClockModel(const ClockModel &model);
+
+// Longest time (ns) that interrupts have been disabled for since the
+// last call
+unsigned long maxInterruptsDisabled();
+
+// Record the time (ns) of every change to an output pin (or stop
+// recording with nullptr)
+void recordOutput(int pin, std::vector<uint64_t> *times);
+
+// Change an input pin at a time (µs) while other code is running, calling
+// the interrupt handler attached to the pin when the clock reaches it
+// (and interrupts are enabled)
+void scheduleInput(int pin, unsigned long time, int value);
+
+// Repeat changes to an output pin on an input pin after a delay (µs),
+// combined with any scheduled input (or stop with -1), as a receiver
+// would see our own transmission
+void echoOutput(int outputPin, int inputPin, unsigned long delay);
+
+// Advance the clock by the duration of the previous pulse and
+// then call the interrupt handler attached to the pin (if any)
+void edge(int pin, unsigned long duration);
+
+// Collects output in memory
+class StringPrint: public Print {
+public:
+	virtual size_t write(uint8_t c) override;
+	virtual size_t write(const uint8_t *buffer, size_t size) override;
+
+	std::string value;
+};
+
+// Reads input from a string and collects output in memory
+class StringStream: public Stream {
+public:
+	explicit StringStream(const std::string &input) : input(input) {}
+
+	virtual size_t write(uint8_t c) override { return output.write(c); }
+	virtual size_t write(const uint8_t *buffer, size_t size) override { return output.write(buffer, size); }
+	virtual int available() override { return position < input.length() ? 1 : 0; }
+	virtual int read() override { return position < input.length() ? (uint8_t)input[position++] : -1; }
+	virtual int peek() override { return position < input.length() ? (uint8_t)input[position] : -1; }
+
+	StringPrint output;
+
+private:
+	std::string input;
+	size_t position = 0;
+};
+
+} // namespace host
+
+#endif
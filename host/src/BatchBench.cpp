@@ -0,0 +1,158 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "Capture.hpp"
+#include "PulseBatch.hpp"
+#include "Replay.hpp"
+
+static constexpr unsigned int DEFAULT_FRAMES = 2000;
+static constexpr unsigned int ITERATIONS = 5;
+
+// HomeEasyV1-like frames separated by receiver noise
+static void synthesise(std::vector<uint32_t> &durations, unsigned int frames) {
+	std::mt19937 rng(433);
+	std::uniform_int_distribution<uint32_t> bit(0, 1);
+	std::uniform_int_distribution<uint32_t> noise(20, 3000);
+	std::uniform_int_distribution<int> jitter(-20, 20);
+	std::uniform_int_distribution<unsigned int> noiseLength(0, 400);
+	const uint32_t bitTime[2] = { 292, 980 };
+
+	for (unsigned int n = 0; n < frames; n++) {
+		unsigned int length = noiseLength(rng);
+
+		for (unsigned int i = 0; i < length; i++) {
+			durations.push_back(noise(rng));
+		}
+
+		for (unsigned int repeat = 0; repeat < 5; repeat++) {
+			durations.push_back(8800 + jitter(rng));
+
+			// The final bit is low so it is part of the next pause
+			for (unsigned int i = 0; i < 49; i++) {
+				durations.push_back(bitTime[bit(rng)] + jitter(rng));
+			}
+		}
+		durations.push_back(8800 + jitter(rng));
+	}
+}
+
+// Batch processing only sees noise close to candidate frames, so the
+// noise rate and time (which skips pulses) can't be compared with the
+// scalar output
+static void removeField(std::vector<std::string> &lines, const std::string &field) {
+	for (std::string &line : lines) {
+		size_t start;
+
+		while ((start = line.find(field)) != std::string::npos) {
+			size_t end = line.find_first_not_of("0123456789", start + field.length());
+
+			line.erase(start, end == std::string::npos ? std::string::npos : end - start);
+		}
+	}
+}
+
+static void removeFields(std::vector<std::string> &lines) {
+	removeField(lines, ",noiseRate: ");
+	removeField(lines, ",startTime: ");
+	removeField(lines, ",endTime: ");
+}
+
+template <typename F>
+static double measure(F function) {
+	double best = 0;
+
+	for (unsigned int i = 0; i < ITERATIONS; i++) {
+		auto start = std::chrono::steady_clock::now();
+		function();
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		if (i == 0 || elapsed.count() < best) {
+			best = elapsed.count();
+		}
+	}
+
+	return best;
+}
+
+int main(int argc, char *argv[]) {
+	Capture capture;
+
+	if (argc > 2) {
+		fprintf(stderr, "Usage: %s [capture]\n", argv[0]);
+		return EXIT_FAILURE;
+	} else if (argc == 2) {
+		if (!capture.load(argv[1])) {
+			fprintf(stderr, "%s: unable to load capture\n", argv[1]);
+			return EXIT_FAILURE;
+		}
+	} else {
+		synthesise(capture.durations, DEFAULT_FRAMES);
+	}
+
+	const std::vector<uint32_t> &durations = capture.durations;
+	std::vector<PulseFrame> frames;
+	std::vector<std::string> scalarLines;
+	std::vector<std::string> batchLines;
+	unsigned long batchEdges = 0;
+
+	double scalar = measure([&] {
+		Replay replay;
+
+		replay.edges(durations.data(), durations.size());
+		replay.flush();
+		scalarLines = replay.lines;
+	});
+
+	double batch = measure([&] {
+		Replay replay;
+
+		PulseBatch::decode(durations.data(), durations.size(), replay);
+		batchLines = replay.lines;
+		batchEdges = replay.count;
+	});
+
+	double scan = measure([&] {
+		PulseBatch::findFrames(durations.data(), durations.size(), frames);
+	});
+
+	const double total = durations.size();
+
+	printf("pulses: %zu\n", durations.size());
+	printf("frames: %zu\n", frames.size());
+	printf("scalar: %.1f Mpulse/s (%zu codes)\n", total / scalar / 1e6, scalarLines.size());
+	printf("batch: %.1f Mpulse/s (%zu codes, %lu pulses to the handler)\n",
+		total / batch / 1e6, batchLines.size(), batchEdges);
+	printf("findFrames: %.1f Mpulse/s\n", total / scan / 1e6);
+
+	removeFields(scalarLines);
+	removeFields(batchLines);
+
+	if (batchLines != scalarLines) {
+		fprintf(stderr, "batch output differs from scalar output\n");
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
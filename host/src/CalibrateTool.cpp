@@ -0,0 +1,127 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include <Host.hpp>
+
+#include "Generator.hpp"
+#include "Transmitter.hpp"
+
+static constexpr int TX_PIN = 3;
+
+struct Board {
+	const char *name;
+	host::ClockModel model;
+};
+
+// Approximate costs of micros(), digitalWrite() and writes to the output
+// register (ns) and the timer interrupts that happen while waiting
+static const Board BOARDS[] = {
+	{ "avr", { 4, 3000, 3500, 500, 1024, 6000 } },
+	{ "rp2040", { 1, 300, 500, 20, 0, 0 } },
+	{ "esp32c3", { 1, 1000, 300, 50, 1000, 2000 } },
+};
+
+class CalibrationTransmitter: public Transmitter {
+public:
+	CalibrationTransmitter() : Transmitter(TX_PIN, false) {}
+
+	using Transmitter::CALIBRATION_CODE;
+};
+
+// Compare the length of the pulses between changes of the output with
+// the expected durations (ignoring the pauses before and after)
+static void printAchieved(const char *name, const std::vector<uint64_t> &changes,
+		const std::vector<uint32_t> &expected) {
+	double total = 0;
+	double min = 0;
+	double max = 0;
+	double square = 0;
+	size_t count = 0;
+
+	for (size_t i = 1; i < changes.size() && i + 1 < expected.size(); i++) {
+		const double error = (changes[i] - changes[i - 1]) / 1000.0 - expected[i];
+
+		if (count == 0 || error < min) {
+			min = error;
+		}
+		if (count == 0 || error > max) {
+			max = error;
+		}
+		total += error;
+		square += error * error;
+		count++;
+	}
+
+	printf("%s: {pulses: %zu,mean: %.1f,min: %.1f,max: %.1f,rms: %.2f}", name, count,
+		count ? total / count : 0, min, max, count ? sqrt(square / count) : 0);
+}
+
+// Runs transmitter calibration with a simulated clock for each board,
+// reporting the actual error in the length of pulses before and after
+// the adjustment (the transmitter can only measure it with micros()) and
+// the longest time that interrupts were disabled for
+int main(int argc, char *argv[]) {
+	const unsigned long preset = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1;
+
+	if (preset >= Transmitter::PRESET_COUNT) {
+		fprintf(stderr, "Usage: %s [preset]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	Generator generator;
+	generator.transmit(Code(CalibrationTransmitter::CALIBRATION_CODE), Transmitter::PRESETS[preset], 0);
+	const std::vector<uint32_t> expected = generator.durations();
+
+	for (const Board &board : BOARDS) {
+		CalibrationTransmitter transmitter;
+		host::StringStream console("S=" + std::to_string(preset) + ",~\n!\n");
+		std::vector<uint64_t> changes;
+
+		host::setMicros(0);
+		host::setClockModel(board.model);
+		host::recordOutput(TX_PIN, &changes);
+		host::maxInterruptsDisabled();
+
+		transmitter.init();
+		transmitter.processInput(&console);
+
+		const unsigned long interruptsDisabled = host::maxInterruptsDisabled();
+
+		host::recordOutput(TX_PIN, nullptr);
+		host::setClockModel(host::ClockModel());
+
+		// Calibration transmits before and after the adjustment
+		const size_t half = changes.size() / 2;
+
+		printf("board: \"%s\"\n%s", board.name, console.output.value.c_str());
+		printf("achieved: {");
+		printAchieved("before", std::vector<uint64_t>(changes.begin(), changes.begin() + half), expected);
+		putchar(',');
+		printAchieved("after", std::vector<uint64_t>(changes.begin() + half, changes.end()), expected);
+		printf(",maxInterruptsDisabled: %.1f}\n", interruptsDisabled / 1000.0);
+	}
+
+	return EXIT_SUCCESS;
+}
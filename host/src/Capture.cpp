@@ -0,0 +1,78 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "Capture.hpp"
+
+bool Capture::load(const std::string &filename) {
+	std::ifstream input(filename);
+	std::string line;
+
+	if (!input) {
+		return false;
+	}
+
+	durations.clear();
+	expected.clear();
+
+	while (std::getline(input, line)) {
+		char *endptr = nullptr;
+		unsigned long value;
+
+		if (line.compare(0, 10, "# expect: ") == 0) {
+			std::istringstream fields(line.substr(10));
+			Label label{"", 1};
+
+			if (!(fields >> label.code)) {
+				return false;
+			}
+			fields >> label.count;
+			expected.push_back(label);
+			continue;
+		} else if (line.empty() || line[0] == '#') {
+			continue;
+		}
+
+		value = strtoul(line.c_str(), &endptr, 10);
+		if (endptr == line.c_str() || (*endptr != 0 && *endptr != '\r')) {
+			return false;
+		}
+
+		durations.push_back(value > UINT32_MAX ? UINT32_MAX : value);
+	}
+
+	return true;
+}
+
+bool Capture::save(const std::string &filename) const {
+	std::ofstream output(filename);
+
+	for (const Label &label : expected) {
+		output << "# expect: " << label.code << ' ' << label.count << '\n';
+	}
+
+	for (const uint32_t duration : durations) {
+		output << duration << '\n';
+	}
+
+	return (bool)output;
+}
@@ -0,0 +1,47 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RF433_OOK_HOST_CAPTURE_HPP
+#define RF433_OOK_HOST_CAPTURE_HPP
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+// A capture is a text file with the duration in µs of each pulse
+// (the time between two edges) on a separate line. Blank lines and
+// lines starting with '#' are ignored.
+//
+// Captures can be labelled with the codes that they contain:
+// # expect: <code> [count]
+class Capture {
+public:
+	struct Label {
+		std::string code;
+		unsigned int count;
+	};
+
+	bool load(const std::string &filename);
+	bool save(const std::string &filename) const;
+
+	std::vector<uint32_t> durations;
+	std::vector<Label> expected;
+};
+
+#endif
@@ -0,0 +1,303 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Code.hpp"
+#include "ReceiverPolicy.hpp"
+
+static constexpr unsigned int CODES = 10000;
+static constexpr unsigned int ITERATIONS = 5;
+static constexpr unsigned int MIN_BITS = Code::MIN_LENGTH;
+static constexpr unsigned int MAX_BITS = Code::INLINE_LENGTH;
+
+// Access to the message functions that are used when receiving a code
+class BenchCode: public Code {
+public:
+	using Code::finalise;
+	using Code::messageAsString;
+	using Code::messageCountBits;
+	using Code::messageGuessFinalBit;
+
+	// Inline in the firmware
+	uint8_t messageValueAt(unsigned int index) const {
+		return (message[index / 2] >> ((index & 1) ? 0 : 4)) & 0xF;
+	}
+
+	uint8_t messageTrailingCount() const {
+		return (messageLength & 0x03);
+	}
+
+	uint8_t messageTrailingValue() const {
+		return (messageValueAt(messageLength >> 2) >> (4 - messageTrailingCount()))
+				& (0x7 >> (3 - messageTrailingCount()));
+	}
+
+	// A code as it is received, with the first 2 bits as the preamble
+	// times and no final bit
+	void receive(std::mt19937 &rng, unsigned int length) {
+		unsigned int ones = 0;
+
+		memset(message.bytes, 0, sizeof(message.bytes));
+		messageLength = length;
+		for (unsigned int i = 0; i < length; i++) {
+			if (rng() & 1) {
+				message[i / 8] |= 0x80 >> (i & 0x7);
+				ones++;
+			}
+		}
+
+		preambleTime[0] = 900;
+		preambleTime[1] = 300;
+		bitTotalTime[0] = (length - ones) * 300;
+		bitTotalTime[1] = ones * 900;
+		valid = true;
+	}
+};
+
+// Previous implementations
+
+static void countBitwise(const BenchCode &code, unsigned int &zeroBitCount, unsigned int &oneBitCount) {
+	uint8_t value;
+
+	zeroBitCount = 0;
+	oneBitCount = 0;
+
+	for (unsigned int i = 0; i < (code.messageLength >> 2); i++) {
+		value = code.messageValueAt(i);
+
+		for (unsigned int bit = 0; bit < 4; bit++) {
+			if (value & (1U << bit)) {
+				oneBitCount++;
+			} else {
+				zeroBitCount++;
+			}
+		}
+	}
+
+	value = code.messageTrailingValue();
+	for (unsigned int bit = 0; bit < 3; bit++) {
+		if (value & (1U << bit)) {
+			oneBitCount++;
+		} else {
+			zeroBitCount++;
+		}
+	}
+}
+
+static uint8_t guessArrays(const BenchCode &code) {
+	const uint8_t trailingValue = code.messageTrailingValue();
+	bool values1bit[1 << 1] = { false };
+	bool values2bit[1 << 2] = { false };
+	bool values3bit[1 << 3] = { false };
+	bool values4bit[1 << 4] = { false };
+
+	for (unsigned int i = 0; i < (code.messageLength >> 2); i++) {
+		values1bit[code.messageValueAt(i) >> 3] = true;
+		values2bit[code.messageValueAt(i) >> 2] = true;
+		values3bit[code.messageValueAt(i) >> 1] = true;
+		values4bit[code.messageValueAt(i)] = true;
+	}
+
+	switch (code.messageTrailingCount()) {
+	case 3:
+		return values4bit[(trailingValue << 1) | 1] ? 1 : 0;
+	case 2:
+		return values3bit[(trailingValue << 1) | 1] ? 1 : 0;
+	case 1:
+		return values2bit[(trailingValue << 1) | 1] ? 1 : 0;
+	default:
+		return values1bit[(trailingValue << 1) | 1] ? 1 : 0;
+	}
+}
+
+static void shiftBytes(BenchCode &code) {
+	uint8_t *message = code.message.bytes;
+
+	for (unsigned int i = (code.messageLength + 2 + 7) / 8 - 1; i > 0; i--) {
+		message[i] = ((message[i - 1] << 6) & 0xC0) | ((message[i] >> 2) & 0x3F);
+	}
+	message[0] >>= 2;
+}
+
+// Alternative implementation
+
+static void shiftWords(BenchCode &code) {
+	const unsigned int words = ((code.messageLength + 2 + 31) / 32);
+	uint8_t *message = code.message.bytes;
+	uint32_t previous = 0;
+
+	for (unsigned int i = 0; i < words; i++) {
+		uint32_t value;
+
+		memcpy(&value, &message[i * 4], sizeof(value));
+		value = __builtin_bswap32(value);
+		const uint32_t shifted = (value >> 2) | (previous << 30);
+		previous = value;
+		value = __builtin_bswap32(shifted);
+		memcpy(&message[i * 4], &value, sizeof(value));
+	}
+}
+
+typedef std::vector<BenchCode> Corpus;
+
+// Run a function over every code in the corpus, returning the best time
+template <class Function>
+static double measure(const Corpus &corpus, Function function) {
+	double best = 0;
+
+	for (unsigned int iteration = 0; iteration < ITERATIONS; iteration++) {
+		auto start = std::chrono::steady_clock::now();
+		for (const BenchCode &code : corpus) {
+			function(code);
+		}
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		if (iteration == 0 || elapsed.count() < best) {
+			best = elapsed.count();
+		}
+	}
+
+	return best;
+}
+
+static void report(const char *name, const char *implementation, double elapsed) {
+	printf("%s (%s): %.1f Mcode/s\n", name, implementation, CODES / elapsed / 1e6);
+}
+
+// Compare the firmware's message functions with the previous and
+// alternative implementations, checking that they have the same results
+int main() {
+	std::mt19937 rng(433);
+	std::uniform_int_distribution<unsigned int> length(MIN_BITS, MAX_BITS);
+	Corpus corpus(CODES);
+	std::vector<std::string> strings(CODES);
+	unsigned long errors = 0;
+	volatile unsigned int sink = 0;
+
+	for (unsigned int i = 0; i < CODES; i++) {
+		corpus[i].receive(rng, length(rng));
+	}
+
+	// Finalised codes for the functions that are used on output
+	Corpus finalised = corpus;
+	for (BenchCode &code : finalised) {
+		if (!code.finalise<DefaultReceiverPolicy>()) {
+			errors++;
+		}
+	}
+
+	for (unsigned int i = 0; i < CODES; i++) {
+		BenchCode shifted = corpus[i];
+		BenchCode words = corpus[i];
+		unsigned int zeroBitCount[2];
+		unsigned int oneBitCount[2];
+		String value;
+		char packedTrailingBits;
+
+		countBitwise(finalised[i], zeroBitCount[0], oneBitCount[0]);
+		finalised[i].messageCountBits(zeroBitCount[1], oneBitCount[1]);
+		if (zeroBitCount[0] != zeroBitCount[1] || oneBitCount[0] != oneBitCount[1]) {
+			errors++;
+		}
+
+		shiftBytes(shifted);
+		shiftWords(words);
+		if (memcmp(shifted.message.bytes, words.message.bytes, (shifted.messageLength + 2 + 7) / 8)) {
+			errors++;
+		}
+
+		// The preamble bits are added to the top of the shifted code
+		shifted.message[0] |= 0x80;
+		shifted.messageLength += 2;
+		const unsigned int last = shifted.messageLength;
+		if (((finalised[i].message[last / 8] >> (7 - (last & 0x7))) & 1) != guessArrays(shifted)
+				|| guessArrays(shifted) != shifted.messageGuessFinalBit()) {
+			errors++;
+		}
+
+		finalised[i].messageAsString(value, packedTrailingBits);
+		strings[i] = value.c_str();
+		if (packedTrailingBits) {
+			strings[i] += '+';
+			strings[i] += packedTrailingBits;
+		}
+		if (memcmp(Code(strings[i].c_str()).message.bytes, finalised[i].message.bytes, (finalised[i].messageLength + 7) / 8)) {
+			errors++;
+		}
+	}
+
+	report("messageCountBits", "bitwise", measure(finalised, [&] (const BenchCode &code) {
+		unsigned int zeroBitCount, oneBitCount;
+		countBitwise(code, zeroBitCount, oneBitCount);
+		sink += zeroBitCount + oneBitCount;
+	}));
+	report("messageCountBits", "firmware", measure(finalised, [&] (const BenchCode &code) {
+		unsigned int zeroBitCount, oneBitCount;
+		code.messageCountBits(zeroBitCount, oneBitCount);
+		sink += zeroBitCount + oneBitCount;
+	}));
+
+	report("finalBit", "arrays", measure(finalised, [&] (const BenchCode &code) {
+		sink += guessArrays(code);
+	}));
+	report("finalBit", "firmware", measure(finalised, [&] (const BenchCode &code) {
+		sink += code.messageGuessFinalBit();
+	}));
+
+	BenchCode copy;
+	report("shift", "bytes", measure(corpus, [&] (const BenchCode &code) {
+		memcpy(copy.message.bytes, code.message.bytes, (code.messageLength + 2 + 7) / 8);
+		copy.messageLength = code.messageLength;
+		shiftBytes(copy);
+		sink += copy.message[0];
+	}));
+	report("shift", "words", measure(corpus, [&] (const BenchCode &code) {
+		memcpy(copy.message.bytes, code.message.bytes, (code.messageLength + 2 + 7) / 8);
+		copy.messageLength = code.messageLength;
+		shiftWords(copy);
+		sink += copy.message[0];
+	}));
+
+	report("finalise", "firmware", measure(corpus, [&] (const BenchCode &code) {
+		copy = code;
+		sink += copy.finalise<DefaultReceiverPolicy>();
+	}));
+
+	report("messageAsString", "firmware", measure(finalised, [&] (const BenchCode &code) {
+		String value;
+		char packedTrailingBits;
+		code.messageAsString(value, packedTrailingBits);
+		sink += value.length();
+	}));
+
+	size_t next = 0;
+	report("Code(const char*)", "firmware", measure(corpus, [&] (const BenchCode &) {
+		sink += Code(strings[next++ % CODES].c_str()).messageLength;
+	}));
+
+	printf("codes: %u (%lu errors)\n", CODES, errors);
+	return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
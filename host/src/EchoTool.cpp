@@ -0,0 +1,157 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include <Host.hpp>
+
+#include "Generator.hpp"
+#include "Replay.hpp"
+#include "Transmitter.hpp"
+
+static constexpr int TX_PIN = 3;
+// Delay between our output and the receiver's output (µs)
+static constexpr unsigned long ECHO_DELAY_US = 100;
+
+// Our transmission, with long pauses so that other codes fit in them
+// (with an even and an odd number of bits, which ends with an edge
+// at the start of the pause)
+static const char *const CODES[] = { "556565565A5A+5", "556565565A5A+2" };
+static const Transmitter::Preset PRESET = { 50000, { 0, 0 }, { 292, 980 }, 3 };
+
+// Another transmitter's code, in each of our pauses
+static const char *const OTHER_CODE = "656565A5A6A6+5";
+static const Transmitter::Preset OTHER_PRESET = { 3960, { 0, 0 }, { 308, 956 }, 1 };
+static constexpr unsigned long OTHER_OFFSET_US = 5000;
+static constexpr unsigned long END_PULSE_US = 50;
+
+struct Board {
+	const char *name;
+	host::ClockModel model;
+};
+
+// The same boards as rf433-calibrate
+static const Board BOARDS[] = {
+	{ "avr", { 4, 3000, 3500, 500, 1024, 6000 } },
+	{ "rp2040", { 1, 300, 500, 20, 0, 0 } },
+	{ "esp32c3", { 1, 1000, 300, 50, 1000, 2000 } },
+};
+
+// Receives while transmitting with a simulated clock for each board, with
+// the receiver hearing our own transmission and another transmitter's
+// codes in the pauses between ours, reporting how many of each were
+// decoded and how many of our own edges were ignored
+static bool echo(const char *value) {
+	const Code code(value);
+	const Code otherCode(OTHER_CODE);
+	unsigned long bits = 0;
+
+	for (unsigned int i = 0; i < code.messageLength; i++) {
+		bits += PRESET.bitTime[code.message[i / 8] & (0x80 >> (i & 0x7)) ? 1 : 0];
+	}
+
+	// Every bit starts with an edge, and the pause after an odd number
+	// of bits starts with one too
+	const unsigned long edges = PRESET.repeat * ((code.messageLength + 1) & ~1U);
+
+	// Every pause in our transmission starts when the previous one ends
+	// plus the length of the bits
+	Generator generator;
+	for (unsigned int n = 0; n <= PRESET.repeat; n++) {
+		generator.transmit(otherCode, OTHER_PRESET,
+			n * (PRESET.pauseTime + bits) + OTHER_OFFSET_US);
+	}
+	const std::vector<uint32_t> durations = generator.durations();
+	const unsigned long end = generator.end + END_PULSE_US + PRESET.pauseTime;
+
+	const std::string input = "P=" + std::to_string(PRESET.pauseTime)
+		+ ",0=" + std::to_string(PRESET.bitTime[0])
+		+ ",1=" + std::to_string(PRESET.bitTime[1])
+		+ ",R=" + std::to_string(PRESET.repeat)
+		+ "," + value + "\n";
+	bool failed = false;
+
+	for (const Board &board : BOARDS) {
+		Transmitter transmitter(TX_PIN, true);
+		host::StringStream console(input);
+		Replay replay;
+		unsigned long time = 0;
+		unsigned long own = 0;
+		unsigned long other = 0;
+		unsigned long unknown = 0;
+
+		host::setClockModel(board.model);
+		host::echoOutput(TX_PIN, Replay::RX_PIN, ECHO_DELAY_US);
+
+		// Each pulse, with a short pulse at the end of the signal so
+		// that the last code ends
+		for (size_t i = 0; i < durations.size(); i += 2) {
+			time += durations[i];
+			host::scheduleInput(Replay::RX_PIN, time, HIGH);
+			time += i + 1 < durations.size() ? durations[i + 1] : END_PULSE_US;
+			host::scheduleInput(Replay::RX_PIN, time, LOW);
+		}
+
+		transmitter.init();
+		transmitter.processInput(&console);
+		host::advanceMicros(end - micros());
+		replay.flush();
+
+		host::echoOutput(-1, -1, 0);
+		host::setClockModel(host::ClockModel());
+
+		for (const std::string &line : replay.lines) {
+			const std::string received = Replay::code(line);
+
+			if (received.empty()) {
+				continue;
+			} else if (received == value) {
+				own++;
+			} else if (received == OTHER_CODE) {
+				other++;
+			} else {
+				unknown++;
+			}
+		}
+
+		printf("echo: {code: \"%s\",board: \"%s\",edges: %lu,suppressedEchoes: %lu,ownDecoded: %lu,otherExpected: %u,otherDecoded: %lu,unknown: %lu}\n",
+			value, board.name, edges, replay.receiver.suppressedEchoes(), own, PRESET.repeat + 1, other, unknown);
+
+		if (replay.receiver.suppressedEchoes() != edges || own || other != PRESET.repeat + 1 || unknown) {
+			failed = true;
+		}
+	}
+
+	return !failed;
+}
+
+int main() {
+	bool success = true;
+
+	for (const char *code : CODES) {
+		if (!echo(code)) {
+			success = false;
+		}
+	}
+
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,131 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include <Host.hpp>
+
+#include "Code.hpp"
+#include "Fuzz.hpp"
+
+// The original parser (before codes could be longer than 190 bits), with
+// the maximum length as a parameter: hex values of 4 bits, optionally
+// followed by "+" and up to 3 trailing bits packed after a leading 1-bit,
+// and values that don't fit are ignored (the trailing bits are shifted by
+// the position in the byte, which the original didn't do after an odd
+// number of values)
+static bool parse(const char *text, unsigned int maxLength, uint8_t *message, unsigned int &messageLength) {
+	bool trailing = false;
+
+	messageLength = 0;
+	memset(message, 0, (maxLength + 7) / 8);
+
+	for (unsigned int i = 0; text[i] != 0; i++) {
+		if ((text[i] >= '0' && text[i] <= '9') || (text[i] >= 'A' && text[i] <= 'F')) {
+			uint8_t value = text[i] < 'A' ? (text[i] - '0') : ((text[i] - 'A') + 10);
+
+			if (trailing) {
+				if (value & 0x8) {
+					if (messageLength + 3 <= maxLength) {
+						message[messageLength / 8] |= (value & 0x7) << (5 - (messageLength & 0x4));
+						messageLength += 3;
+					}
+				} else if (value & 0x4) {
+					if (messageLength + 2 <= maxLength) {
+						message[messageLength / 8] |= (value & 0x3) << (6 - (messageLength & 0x4));
+						messageLength += 2;
+					}
+				} else if (value & 0x2) {
+					if (messageLength + 1 <= maxLength) {
+						message[messageLength / 8] |= (value & 0x1) << (7 - (messageLength & 0x4));
+						messageLength++;
+					}
+				}
+			} else {
+				if (messageLength + 4 <= maxLength) {
+					message[messageLength / 8] |= value << (4 - (messageLength & 0x4));
+					messageLength += 4;
+				}
+			}
+		} else if (text[i] == '+') {
+			if (text[i + 1] == 0 || text[i + 2] != 0) {
+				return false;
+			}
+
+			trailing = true;
+		} else {
+			return false;
+		}
+	}
+
+	return messageLength >= Code::MIN_LENGTH;
+}
+
+// Compares the parser with the original parser (with and without an
+// overflow buffer) and checks that the output of valid codes can be
+// parsed again
+static void check(const std::string &text, uint8_t *overflow) {
+	uint8_t message[(Code::MAX_LENGTH + 7) / 8];
+	unsigned int messageLength;
+	const Code code(text.c_str(), overflow);
+	const bool valid = parse(text.c_str(), code.capacity(), message, messageLength);
+
+	FUZZ_CHECK(code.capacity() == (overflow != nullptr ? Code::MAX_LENGTH : Code::INLINE_LENGTH));
+	FUZZ_CHECK(code.isValid() == valid);
+
+	if (!valid) {
+		return;
+	}
+
+	// Unused bits in the last byte are 0
+	FUZZ_CHECK(code.messageLength == messageLength);
+	for (unsigned int i = 0; i < (messageLength + 7) / 8; i++) {
+		FUZZ_CHECK(code.message[i] == message[i]);
+	}
+
+	host::StringPrint output;
+	static const std::string prefix = "{code: \"";
+
+	output.print(code);
+	FUZZ_CHECK(output.value.compare(0, prefix.length(), prefix) == 0);
+
+	const std::string printed = output.value.substr(prefix.length(),
+		output.value.find('"', prefix.length()) - prefix.length());
+	uint8_t reparsedOverflow[Code::OVERFLOW_SIZE];
+	const Code reparsed(printed.c_str(), reparsedOverflow);
+
+	FUZZ_CHECK(reparsed.isValid());
+	FUZZ_CHECK(reparsed.messageLength == code.messageLength);
+	for (unsigned int i = 0; i < (code.messageLength + 7) / 8; i++) {
+		FUZZ_CHECK(reparsed.message[i] == code.message[i]);
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+	const std::string text(reinterpret_cast<const char *>(data), strnlen(reinterpret_cast<const char *>(data), size));
+	uint8_t overflow[Code::OVERFLOW_SIZE];
+
+	check(text, nullptr);
+	check(text, overflow);
+	return 0;
+}
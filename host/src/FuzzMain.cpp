@@ -0,0 +1,108 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Fuzz.hpp"
+
+static constexpr unsigned long RUNS = 200000;
+static constexpr size_t MAX_SIZE = 300;
+
+// Characters that mean something to the parsers
+static const char ALPHABET[] = "0123456789ABCDEFabcdef+,=?!~-. \r\nSRPHLBIAxyz";
+
+static const char *const CRASH_FILENAME = "fuzz-crash";
+static std::vector<uint8_t> data;
+
+// Save the input that failed a check so that it can be run again
+static void crash(int signal) {
+	int fd = open(CRASH_FILENAME, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+	if (fd >= 0) {
+		if (write(fd, data.data(), data.size()) < 0) {
+			// Nothing else can be done
+		}
+		close(fd);
+	}
+
+	::signal(signal, SIG_DFL);
+	raise(signal);
+}
+
+static std::vector<uint8_t> readFile(const char *filename) {
+	std::vector<uint8_t> data;
+	FILE *file = fopen(filename, "rb");
+	int c;
+
+	if (file == nullptr) {
+		perror(filename);
+		exit(EXIT_FAILURE);
+	}
+
+	while ((c = fgetc(file)) != EOF) {
+		data.push_back(c);
+	}
+	fclose(file);
+	return data;
+}
+
+// Runs a fuzz target without libFuzzer, with the inputs from files or
+// random inputs made from the characters that the parsers use
+int main(int argc, char *argv[]) {
+	if (argc > 1) {
+		for (int i = 1; i < argc; i++) {
+			data = readFile(argv[i]);
+			LLVMFuzzerTestOneInput(data.data(), data.size());
+		}
+
+		printf("fuzz: {runs: %d}\n", argc - 1);
+		return EXIT_SUCCESS;
+	}
+
+	std::mt19937 rng(433);
+	std::uniform_int_distribution<size_t> size(0, MAX_SIZE);
+	std::uniform_int_distribution<size_t> character(0, sizeof(ALPHABET) - 2);
+
+	signal(SIGABRT, crash);
+
+	for (unsigned long run = 0; run < RUNS; run++) {
+		// Some inputs are only hex digits so that there are long codes
+		const unsigned int other = (rng() % 3) ? 4 : 0;
+
+		data.resize(size(rng));
+
+		for (uint8_t &c : data) {
+			c = (rng() % 16 < other) ? ALPHABET[character(rng)] : ALPHABET[rng() & 0xF];
+		}
+
+		LLVMFuzzerTestOneInput(data.data(), data.size());
+	}
+
+	printf("fuzz: {runs: %lu}\n", RUNS);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,80 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+#include <Host.hpp>
+
+#include "Fuzz.hpp"
+#include "Transmitter.hpp"
+
+// Checks the configuration instead of transmitting codes (which would
+// wait for the simulated clock)
+class FuzzTransmitter: public Transmitter {
+public:
+	FuzzTransmitter() : Transmitter(3, false) {}
+
+	void check() const {
+		FUZZ_CHECK(length <= MAX_LENGTH);
+		FUZZ_CHECK(prePauseTime <= MAX_PAUSE_US);
+		FUZZ_CHECK(interPauseTime <= MAX_PAUSE_US);
+		FUZZ_CHECK(postPauseTime <= MAX_PAUSE_US);
+		FUZZ_CHECK(preambleTime[0] <= MAX_PREAMBLE_US);
+		FUZZ_CHECK(preambleTime[1] <= MAX_PREAMBLE_US);
+		FUZZ_CHECK(bitTime[0] <= MAX_BIT_US);
+		FUZZ_CHECK(bitTime[1] <= MAX_BIT_US);
+		FUZZ_CHECK(repeat > 0 && repeat <= MAX_REPEAT);
+		FUZZ_CHECK(edgeAdjust <= MAX_EDGE_ADJUST_US);
+	}
+
+	unsigned long transmitted = 0;
+
+protected:
+	virtual void transmit(const Code &code) override {
+		FUZZ_CHECK(code.isValid());
+		FUZZ_CHECK(code.messageLength >= Code::MIN_LENGTH);
+		FUZZ_CHECK(code.messageLength <= Code::MAX_LENGTH);
+		check();
+		transmitted++;
+	}
+};
+
+// Processes command lines, checking that the configuration stays within
+// its limits and that only valid codes are transmitted
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+	FuzzTransmitter transmitter;
+	host::StringStream input(std::string(reinterpret_cast<const char *>(data), size));
+
+	transmitter.processInput(&input);
+	transmitter.check();
+
+	// Every code that is transmitted is output first, except for
+	// calibration which transmits twice
+	size_t outputs = 0;
+	for (size_t pos = 0; (pos = input.output.value.find("transmit: ", pos)) != std::string::npos; pos++) {
+		outputs++;
+	}
+	for (size_t pos = 0; (pos = input.output.value.find("calibrate: ", pos)) != std::string::npos; pos++) {
+		outputs += 2;
+	}
+	FUZZ_CHECK(outputs == transmitter.transmitted);
+	return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "Capture.hpp"
+#include "Generator.hpp"
+
+static int usage(const char *name) {
+	fprintf(stderr, "Usage: %s [options] <code> <capture>\n"
+		"  -s <preset>   transmitter preset (default 1)\n"
+		"  -n <count>    number of transmissions (default 1)\n"
+		"  -g <µs>       gap between transmissions (default 100000)\n"
+		"  -j <µs>       timing jitter (standard deviation)\n"
+		"  -d <ppm>      transmitter clock drift\n"
+		"  -l <p>        probability of losing each high pulse\n"
+		"  -r <rate>     noise pulses per second\n"
+		"  -x <code>     another code transmitted at the same time\n"
+		"  -o <µs>       start of the other code (default 20000)\n"
+		"  -S <seed>     random number seed\n", name);
+	return EXIT_FAILURE;
+}
+
+// Generates a capture of a code being transmitted with a preset,
+// with impairments and noise
+int main(int argc, char *argv[]) {
+	unsigned long presetIndex = 1;
+	unsigned long count = 1;
+	double gap = 100000;
+	double noiseRate = 0;
+	const char *otherCode = nullptr;
+	double otherOffset = 20000;
+	unsigned long seed = 433;
+	Impairments impairments;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "s:n:g:j:d:l:r:x:o:S:")) != -1) {
+		switch (opt) {
+		case 's':
+			presetIndex = strtoul(optarg, nullptr, 10);
+			break;
+
+		case 'n':
+			count = strtoul(optarg, nullptr, 10);
+			break;
+
+		case 'g':
+			gap = strtod(optarg, nullptr);
+			break;
+
+		case 'j':
+			impairments.jitter = strtod(optarg, nullptr);
+			break;
+
+		case 'd':
+			impairments.drift = strtod(optarg, nullptr);
+			break;
+
+		case 'l':
+			impairments.dropout = strtod(optarg, nullptr);
+			break;
+
+		case 'r':
+			noiseRate = strtod(optarg, nullptr);
+			break;
+
+		case 'x':
+			otherCode = optarg;
+			break;
+
+		case 'o':
+			otherOffset = strtod(optarg, nullptr);
+			break;
+
+		case 'S':
+			seed = strtoul(optarg, nullptr, 10);
+			break;
+
+		default:
+			return usage(argv[0]);
+		}
+	}
+
+	if (optind + 2 != argc) {
+		return usage(argv[0]);
+	}
+
+	if (presetIndex >= Transmitter::PRESET_COUNT) {
+		fprintf(stderr, "%lu: unknown preset\n", presetIndex);
+		return EXIT_FAILURE;
+	}
+
+	const Transmitter::Preset &preset = Transmitter::PRESETS[presetIndex];
+	uint8_t overflow[2][Code::OVERFLOW_SIZE];
+	const Code code(argv[optind], overflow[0]);
+	const Code other(otherCode ? otherCode : "", overflow[1]);
+	Generator generator(seed);
+	Capture capture;
+	// Silence before the first transmission, as there is between them
+	double time = gap;
+
+	if (!code.isValid() || (otherCode && !other.isValid())) {
+		fprintf(stderr, "invalid code\n");
+		return EXIT_FAILURE;
+	}
+
+	for (unsigned long i = 0; i < count; i++) {
+		if (otherCode) {
+			generator.transmit(other, preset, time + otherOffset, impairments);
+		}
+
+		time = generator.transmit(code, preset, time, impairments) + gap;
+	}
+
+	generator.noise(noiseRate, 20, 150);
+	capture.durations = generator.durations();
+
+	// Every repeat is received as a separate code
+	capture.expected.push_back({ argv[optind], (unsigned int)(count * preset.repeat) });
+	if (otherCode) {
+		capture.expected.push_back({ otherCode, (unsigned int)(count * preset.repeat) });
+	}
+
+	if (!capture.save(argv[optind + 1])) {
+		fprintf(stderr, "%s: unable to save capture\n", argv[optind + 1]);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
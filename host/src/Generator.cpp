@@ -0,0 +1,134 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "Generator.hpp"
+
+double Generator::transmit(const Code &code, const Transmitter::Preset &preset,
+		double start, const Impairments &impairments) {
+	std::normal_distribution<double> jitter(0, impairments.jitter > 0 ? impairments.jitter : 1);
+	std::bernoulli_distribution dropout(impairments.dropout);
+	const double scale = 1 + impairments.drift / 1e6;
+	double time = start;
+	bool high = true;
+
+	auto pulse = [&] (unsigned int duration) {
+		double length = duration * scale;
+
+		if (!duration) {
+			return;
+		}
+
+		if (impairments.jitter > 0) {
+			length = std::max(1.0, length + jitter(rng));
+		}
+
+		// A low pulse continues until the next high pulse
+		if (high && !(impairments.dropout > 0 && dropout(rng))) {
+			on(time, length);
+		}
+
+		time += length;
+		high = !high;
+	};
+
+	auto pause = [&] (unsigned int duration) {
+		time += duration * scale;
+		high = true;
+	};
+
+	pause(preset.pauseTime);
+
+	for (unsigned int n = 0; n < preset.repeat; n++) {
+		if (n > 0) {
+			pause(preset.pauseTime);
+		}
+
+		if (preset.preambleTime[0] || preset.preambleTime[1]) {
+			pulse(preset.preambleTime[0]);
+			pulse(preset.preambleTime[1]);
+		}
+
+		for (unsigned int i = 0; i < code.messageLength; i++) {
+			uint8_t bit = code.message[i / 8] & (0x80 >> (i & 0x7)) ? 1 : 0;
+
+			pulse(preset.bitTime[bit]);
+		}
+	}
+
+	pause(preset.pauseTime);
+
+	end = std::max(end, time);
+	return time;
+}
+
+void Generator::noise(double rate, uint32_t minDuration, uint32_t maxDuration) {
+	std::exponential_distribution<double> interval(rate / 1e6);
+	std::uniform_int_distribution<uint32_t> duration(minDuration, maxDuration);
+
+	if (rate <= 0) {
+		return;
+	}
+
+	for (double time = interval(rng); time < end; time += interval(rng)) {
+		on(time, duration(rng));
+	}
+}
+
+void Generator::on(double start, double duration) {
+	carrier.push_back({ start, start + duration });
+}
+
+std::vector<uint32_t> Generator::durations() const {
+	std::vector<std::pair<double, double>> sorted = carrier;
+	std::vector<uint32_t> durations;
+	double last = 0;
+
+	std::sort(sorted.begin(), sorted.end());
+
+	for (size_t i = 0; i < sorted.size(); ) {
+		double start = sorted[i].first;
+		double finish = sorted[i].second;
+
+		// Combine overlapping pulses
+		for (i++; i < sorted.size() && sorted[i].first <= finish; i++) {
+			finish = std::max(finish, sorted[i].second);
+		}
+
+		// Edges happen at whole µs
+		uint32_t rise = std::lround(start - last);
+		uint32_t fall = std::lround(finish - start);
+
+		if (rise == 0 && !durations.empty()) {
+			// Too close to the previous pulse to be separate
+			durations.back() += fall;
+		} else {
+			durations.push_back(rise);
+			durations.push_back(std::max(fall, 1U));
+		}
+		last += rise + std::max(fall, 1U);
+	}
+
+	if (end > last) {
+		durations.push_back(std::lround(end - last));
+	}
+
+	return durations;
+}
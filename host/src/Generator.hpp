@@ -0,0 +1,66 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RF433_OOK_HOST_GENERATOR_HPP
+#define RF433_OOK_HOST_GENERATOR_HPP
+
+#include <stdint.h>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Code.hpp"
+#include "Transmitter.hpp"
+
+// Imperfections of the transmitter and the radio channel
+struct Impairments {
+	double jitter = 0; // Standard deviation of each pulse (µs)
+	double drift = 0; // Error in the transmitter's clock (ppm)
+	double dropout = 0; // Probability of losing each high pulse
+};
+
+// Builds the received signal from transmissions and noise as the times
+// that the carrier is on, so that overlapping transmissions are combined
+// in the same way as a receiver would see them
+class Generator {
+public:
+	explicit Generator(unsigned int seed = 433) : rng(seed) {}
+
+	// Transmit a code in the same way as Transmitter::transmit() with a
+	// preset, starting at a time (µs) and returning the time it ends
+	double transmit(const Code &code, const Transmitter::Preset &preset,
+		double start, const Impairments &impairments = Impairments());
+
+	// Add short noise pulses at random times up to the end of the signal
+	void noise(double rate, uint32_t minDuration, uint32_t maxDuration);
+
+	// Durations between the edges, starting from time 0 and ending
+	// with an edge at the end of the signal
+	std::vector<uint32_t> durations() const;
+
+	double end = 0;
+
+private:
+	void on(double start, double duration);
+
+	std::mt19937 rng;
+	std::vector<std::pair<double, double>> carrier;
+};
+
+#endif
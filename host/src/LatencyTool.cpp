@@ -0,0 +1,207 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Latency of each stage after the end of a code, from the "latency:" lines
+// that are output when the firmware is built with TRACE_LATENCY
+static const char *const STAGES[] = { "queued", "dequeued", "decoded", "output" };
+static constexpr unsigned int STAGE_COUNT = sizeof(STAGES) / sizeof(STAGES[0]);
+
+// Period (µs) over which the lowest offset between the clocks is used to
+// estimate the drift between them
+static constexpr int64_t DRIFT_PERIOD_US = 10000000;
+
+struct Record {
+	unsigned long endTime;
+	unsigned long stage[STAGE_COUNT];
+	int64_t arrival; // Host time (µs) that the line was read
+};
+
+// Parse a "latency: {endTime: N,queued: N,...}" line
+static bool parse(const std::string &line, Record &record) {
+	static const std::string prefix = "latency: {endTime: ";
+	const char *value;
+	char *end;
+
+	size_t start = line.find(prefix);
+	if (start == std::string::npos) {
+		return false;
+	}
+
+	value = line.c_str() + start + prefix.length();
+	record.endTime = strtoul(value, &end, 10);
+	if (end == value) {
+		return false;
+	}
+
+	for (unsigned int i = 0; i < STAGE_COUNT; i++) {
+		const std::string name = std::string(",") + STAGES[i] + ": ";
+
+		if (strncmp(end, name.c_str(), name.length())) {
+			return false;
+		}
+
+		value = end + name.length();
+		record.stage[i] = strtoul(value, &end, 10);
+		if (end == value) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static unsigned long percentile(const std::vector<unsigned long> &sorted, unsigned int n) {
+	// Nearest rank
+	size_t rank = (sorted.size() * n + 99) / 100;
+
+	return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static void report(const char *name, std::vector<unsigned long> values) {
+	if (values.empty()) {
+		return;
+	}
+
+	std::sort(values.begin(), values.end());
+
+	printf("latency: {stage: \"%s\",count: %zu,p50: %lu,p90: %lu,p99: %lu,max: %lu}\n",
+		name, values.size(), percentile(values, 50), percentile(values, 90),
+		percentile(values, 99), values.back());
+}
+
+// Reads the output of the firmware (e.g. from a serial port) and reports
+// percentiles of the latency (µs) of each stage after the end of a code
+//
+// With -t the time that each line is read is also used, as the latency
+// above the lowest observed offset between the clocks (which includes
+// the minimum time to output a line) after removing the drift between
+// the clocks
+int main(int argc, char *argv[]) {
+	bool arrival = false;
+	std::vector<Record> records;
+	std::string line;
+
+	if (argc == 2 && !strcmp(argv[1], "-t")) {
+		arrival = true;
+	} else if (argc != 1) {
+		fprintf(stderr, "Usage: %s [-t] < output\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	while (std::getline(std::cin, line)) {
+		Record record;
+
+		if (parse(line, record)) {
+			record.arrival = std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
+			records.push_back(record);
+		}
+	}
+
+	for (unsigned int i = 0; i < STAGE_COUNT; i++) {
+		std::vector<unsigned long> values;
+
+		for (const Record &record : records) {
+			values.push_back(record.stage[i]);
+		}
+
+		report(STAGES[i], values);
+	}
+
+	if (arrival && !records.empty()) {
+		std::vector<int64_t> offsets;
+		std::vector<unsigned long> values;
+		std::vector<std::pair<int64_t, int64_t>> minima;
+		uint32_t previous = 0;
+		int64_t time = 0;
+		double drift = 0;
+
+		// The firmware's clock is 32-bit on some boards, so it's unwrapped
+		// using the difference from the previous line
+		for (size_t i = 0; i < records.size(); i++) {
+			const uint32_t output = records[i].endTime + records[i].stage[STAGE_COUNT - 1];
+
+			time += (i == 0) ? output : (uint32_t)(output - previous);
+			previous = output;
+			offsets.push_back(records[i].arrival - time);
+		}
+
+		// The clocks drift apart, so use the lowest offset in each period
+		// to estimate the drift (least squares) and remove it
+		for (size_t i = 0; i < records.size(); i++) {
+			const int64_t period = (records[i].arrival - records[0].arrival) / DRIFT_PERIOD_US;
+
+			if (minima.empty() || minima.back().first != period) {
+				minima.push_back({ period, i });
+			} else if (offsets[i] < offsets[minima.back().second]) {
+				minima.back().second = i;
+			}
+		}
+
+		if (minima.size() >= 2) {
+			double meanTime = 0;
+			double meanOffset = 0;
+			double covariance = 0;
+			double variance = 0;
+
+			for (const auto &minimum : minima) {
+				meanTime += records[minimum.second].arrival - records[0].arrival;
+				meanOffset += offsets[minimum.second];
+			}
+			meanTime /= minima.size();
+			meanOffset /= minima.size();
+
+			for (const auto &minimum : minima) {
+				const double x = records[minimum.second].arrival - records[0].arrival - meanTime;
+
+				covariance += x * (offsets[minimum.second] - meanOffset);
+				variance += x * x;
+			}
+
+			drift = covariance / variance;
+		}
+
+		for (size_t i = 0; i < records.size(); i++) {
+			offsets[i] -= (int64_t)(drift * (records[i].arrival - records[0].arrival));
+		}
+
+		const int64_t minimum = *std::min_element(offsets.begin(), offsets.end());
+
+		for (size_t i = 0; i < records.size(); i++) {
+			values.push_back(records[i].stage[STAGE_COUNT - 1] + (offsets[i] - minimum));
+		}
+
+		report("host", values);
+		// Drift of the firmware's clock relative to the host (ppm)
+		printf("clock: {drift: %.1f}\n", -drift * 1000000);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Code.hpp"
+#include "Replay.hpp"
+
+static constexpr unsigned int FRAMES = 2000;
+static constexpr uint32_t PAUSE_US = 10000;
+static constexpr uint32_t ZERO_US = 300;
+static constexpr uint32_t ONE_US = 900;
+static constexpr uint32_t JITTER_US = 40;
+
+typedef std::vector<uint8_t> Bits;
+
+// Frames of random short (0) and long (1) pulses after a pause, ending
+// with a high pulse (the receiver guesses the final bit)
+static void generate(unsigned int length, std::mt19937 &rng,
+		std::vector<Bits> &frames, std::vector<uint32_t> &durations) {
+	std::uniform_int_distribution<uint32_t> jitter(0, 2 * JITTER_US);
+
+	for (unsigned int i = 0; i < FRAMES; i++) {
+		Bits bits(length);
+
+		durations.push_back(PAUSE_US);
+		for (uint8_t &bit : bits) {
+			bit = rng() & 1;
+			durations.push_back((bit ? ONE_US : ZERO_US) - JITTER_US + jitter(rng));
+		}
+
+		frames.push_back(bits);
+	}
+
+	durations.push_back(PAUSE_US);
+}
+
+static uint8_t fromHex(char c) {
+	return c < 'A' ? (c - '0') : (c - 'A' + 10);
+}
+
+// Unpack the code from a "receive:" line
+static Bits unpack(const std::string &code) {
+	Bits bits;
+
+	for (size_t i = 0; i < code.length(); i++) {
+		uint8_t value = fromHex(code[i]);
+		unsigned int count = 4;
+
+		if (code[i] == '+') {
+			continue;
+		} else if (i > 0 && code[i - 1] == '+') {
+			// Trailing bits are packed after a leading 1-bit
+			for (count = 3; count > 0 && !(value & (1 << count)); count--);
+		}
+
+		for (unsigned int bit = count; bit-- > 0; ) {
+			bits.push_back((value >> bit) & 1);
+		}
+	}
+
+	return bits;
+}
+
+// Replay frames of the same length through the receiver, checking that
+// every frame is received and measuring the cost per pulse
+static bool bench(const char *name, unsigned int length) {
+	std::mt19937 rng(433);
+	std::vector<Bits> frames;
+	std::vector<uint32_t> durations;
+	Replay replay;
+	unsigned long errors = 0;
+
+	generate(length, rng, frames, durations);
+
+	auto start = std::chrono::steady_clock::now();
+	replay.edges(durations.data(), durations.size());
+	replay.flush();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	size_t frame = 0;
+
+	for (const std::string &line : replay.lines) {
+		const std::string code = Replay::code(line);
+
+		if (code.empty()) {
+			continue;
+		}
+
+		Bits bits = unpack(code);
+
+		// Ignore the guessed final bit
+		if (frame >= frames.size() || bits.size() != length + 1
+				|| !std::equal(frames[frame].begin(), frames[frame].end(), bits.begin())) {
+			errors++;
+		}
+		frame++;
+	}
+
+	errors += frames.size() - std::min(frame, frames.size());
+
+	printf("%s: %u bits, %.1f ns/pulse (%zu codes, %lu errors)\n",
+		name, length + 1, elapsed.count() * 1e9 / durations.size(), frame, errors);
+	return errors == 0;
+}
+
+int main() {
+	bool ok = true;
+
+	printf("code: %zu bytes (%u bits inline, maximum %u bits)\n", sizeof(Code),
+		Code::INLINE_SIZE * 8, Code::MAX_LENGTH + 2);
+
+	ok = bench("short", 12 * 4 + 1) && ok;
+	ok = bench("medium", 48 * 4 - 1) && ok;
+	ok = bench("long", Code::MAX_LENGTH + 1) && ok;
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
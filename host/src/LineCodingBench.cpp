@@ -0,0 +1,177 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "Code.hpp"
+#include "LineCoding.hpp"
+
+static constexpr unsigned int CODES = 10000;
+static constexpr unsigned int ITERATIONS = 5;
+static constexpr unsigned int MIN_BITS = 16;
+static constexpr unsigned int MAX_BITS = 64;
+
+typedef std::vector<uint8_t> Bits;
+
+// Encode logical bits as pulses for each line coding, ending with the
+// guessed final low pulse (as for a received code)
+static void addPulse(Code &pulses, uint8_t value) {
+	const uint8_t mask = 0x80 >> (pulses.messageLength & 0x07);
+
+	if (value) {
+		pulses.message[pulses.messageLength / 8] |= mask;
+	} else {
+		pulses.message[pulses.messageLength / 8] &= ~mask;
+	}
+	pulses.messageLength++;
+}
+
+static void encodeManchester(const Bits &bits, std::mt19937 &rng, Code &pulses) {
+	std::vector<uint8_t> halves;
+
+	for (uint8_t bit : bits) {
+		halves.push_back(bit ? 0 : 1);
+		halves.push_back(bit ? 1 : 0);
+	}
+
+	// Low half-bits at the start and end are part of the pauses
+	while (!halves.empty() && !halves.back()) {
+		halves.pop_back();
+	}
+
+	pulses.messageLength = 0;
+
+	for (size_t i = halves[0] ? 0 : 1; i < halves.size(); ) {
+		size_t length = 1;
+
+		while (i + length < halves.size() && halves[i + length] == halves[i]) {
+			length++;
+		}
+
+		addPulse(pulses, length - 1);
+		i += length;
+	}
+
+	addPulse(pulses, rng() & 1);
+}
+
+static void encodePWM(const Bits &bits, std::mt19937 &rng, Code &pulses) {
+	pulses.messageLength = 0;
+
+	for (uint8_t bit : bits) {
+		addPulse(pulses, bit);
+		addPulse(pulses, !bit);
+	}
+
+	pulses.messageLength--;
+	addPulse(pulses, rng() & 1);
+}
+
+static void encodePPM(const Bits &bits, std::mt19937 &rng, Code &pulses) {
+	pulses.messageLength = 0;
+
+	for (uint8_t bit : bits) {
+		addPulse(pulses, 0);
+		addPulse(pulses, bit);
+	}
+
+	addPulse(pulses, 0);
+	addPulse(pulses, rng() & 1);
+}
+
+typedef void (*Encoder)(const Bits &bits, std::mt19937 &rng, Code &pulses);
+
+static bool matches(const Code &code, const Bits &bits) {
+	if (code.messageLength != bits.size()) {
+		return false;
+	}
+
+	for (size_t i = 0; i < bits.size(); i++) {
+		if (((code.message[i / 8] >> (7 - (i & 0x07))) & 1) != bits[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Demodulate a corpus of encoded codes with each line coding, checking
+// that the original bits are returned and measuring the throughput
+static bool bench(const LineCoding &lineCoding, Encoder encode) {
+	std::mt19937 rng(433);
+	std::uniform_int_distribution<unsigned int> length(MIN_BITS, MAX_BITS);
+	std::vector<Bits> corpus(CODES);
+	std::vector<Code> pulses(CODES);
+	unsigned long totalBits = 0;
+	unsigned long errors = 0;
+	double best = 0;
+
+	for (unsigned int i = 0; i < CODES; i++) {
+		corpus[i].resize(length(rng));
+		for (uint8_t &bit : corpus[i]) {
+			bit = rng() & 1;
+		}
+
+		encode(corpus[i], rng, pulses[i]);
+		totalBits += corpus[i].size();
+	}
+
+	for (unsigned int iteration = 0; iteration < ITERATIONS; iteration++) {
+		Code bits;
+
+		auto start = std::chrono::steady_clock::now();
+		for (unsigned int i = 0; i < CODES; i++) {
+			if (!lineCoding.demodulate(pulses[i], bits)) {
+				errors++;
+			}
+		}
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		if (iteration == 0 || elapsed.count() < best) {
+			best = elapsed.count();
+		}
+	}
+
+	errors = 0;
+	for (unsigned int i = 0; i < CODES; i++) {
+		Code bits;
+
+		if (!lineCoding.demodulate(pulses[i], bits) || !matches(bits, corpus[i])) {
+			errors++;
+		}
+	}
+
+	printf("%s: %.1f Mcode/s, %.1f Mbit/s (%u codes, %lu errors)\n", lineCoding.name(),
+		CODES / best / 1e6, totalBits / best / 1e6, CODES, errors);
+	return errors == 0;
+}
+
+int main() {
+	bool ok = true;
+
+	ok = bench(ManchesterLineCoding(), encodeManchester) && ok;
+	ok = bench(PWMLineCoding(), encodePWM) && ok;
+	ok = bench(PPMLineCoding(), encodePPM) && ok;
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,66 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "LineScanner.hpp"
+
+bool LineScanner::Line::startsWith(const char *prefix) const {
+	const size_t prefixLength = strlen(prefix);
+
+	return length >= prefixLength && !memcmp(data, prefix, prefixLength);
+}
+
+bool LineScanner::next(Line &line) {
+	while (scanned < end) {
+		const char *found = (const char *)memchr(&buffer[scanned], '\n', end - scanned);
+
+		if (found == nullptr) {
+			scanned = end;
+			break;
+		}
+
+		line.data = &buffer[start];
+		line.length = found - line.data;
+		if (line.length > 0 && line.data[line.length - 1] == '\r') {
+			line.length--;
+		}
+
+		start = scanned = found - buffer + 1;
+
+		if (discarding) {
+			// The end of a line that didn't fit
+			discarding = false;
+			continue;
+		}
+
+		return true;
+	}
+
+	// Move the partial line to the start of the buffer
+	if (start == 0 && end == SIZE) {
+		discarding = true;
+		end = 0;
+	} else if (start > 0) {
+		memmove(buffer, &buffer[start], end - start);
+		end -= start;
+	}
+	start = 0;
+	scanned = end;
+	return false;
+}
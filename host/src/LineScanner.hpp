@@ -0,0 +1,56 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RF433_OOK_HOST_LINE_SCANNER_HPP
+#define RF433_OOK_HOST_LINE_SCANNER_HPP
+
+#include <stddef.h>
+
+// Finds complete lines in data that is read into its buffer without
+// copying them, keeping any partial line for the next read. Lines that
+// don't fit in the buffer are discarded.
+class LineScanner {
+public:
+	struct Line {
+		const char *data;
+		size_t length;
+
+		bool startsWith(const char *prefix) const;
+	};
+
+	// Space to read into, which is never empty
+	char *space() { return &buffer[end]; }
+	size_t spaceLength() const { return SIZE - end; }
+	// Data has been read into the space
+	void added(size_t length) { end += length; }
+
+	// Get the next complete line (without the line ending), which
+	// remains valid until this returns false
+	bool next(Line &line);
+
+	static constexpr size_t SIZE = 4096;
+
+private:
+	char buffer[SIZE];
+	size_t start = 0; // Start of the current line
+	size_t scanned = 0; // Data without a line ending
+	size_t end = 0;
+	bool discarding = false;
+};
+
+#endif
@@ -0,0 +1,148 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "PulseBatch.hpp"
+#include "Replay.hpp"
+
+// The compiler will use whatever vector instructions are available
+// for the target (e.g. SSE2/AVX2/NEON) to implement these types, the
+// functions using them are all internal so the ABI doesn't matter
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+typedef uint32_t PulseVector __attribute__((vector_size(32)));
+typedef uint64_t PulseVectorWords __attribute__((vector_size(32)));
+
+static constexpr size_t LANES = sizeof(PulseVector) / sizeof(uint32_t);
+
+static inline PulseVector load(const uint32_t *durations) {
+	PulseVector value;
+
+	memcpy(&value, durations, sizeof(value));
+	return value;
+}
+
+static inline bool any(PulseVector mask) {
+	PulseVectorWords words = (PulseVectorWords)mask;
+
+	return (words[0] | words[1] | words[2] | words[3]) != 0;
+}
+
+void PulseBatch::findFrames(const uint32_t *durations, size_t count,
+		std::vector<PulseFrame> &frames) {
+	// Index of the last pulse that isn't a valid bit (the previous break)
+	size_t previous = SIZE_MAX;
+	bool previousPause = false;
+	size_t i = 0;
+
+	frames.clear();
+
+	unsigned int glitches = 0;
+
+	auto process = [&] (size_t index) {
+		const bool isPause = durations[index] >= MIN_PAUSE_US;
+
+		// Short pulses are merged into the bits either side of them after
+		// sampling, which can include another short pulse each time
+		if (previousPause && durations[index] < MIN_BIT_US
+				&& index - previous - 1 > 2 + MIN_SAMPLES
+				&& glitches < 2 * MAX_GLITCHES) {
+			glitches++;
+			return;
+		}
+
+		if (previousPause && index - previous - 1 >= MIN_FRAME_BITS) {
+			frames.push_back({ previous, index });
+		}
+
+		previous = index;
+		previousPause = isPause;
+		glitches = 0;
+	};
+
+	for (; i + LANES <= count; i += LANES) {
+		const PulseVector duration = load(&durations[i]);
+		const PulseVector breaks = (PulseVector)((duration < MIN_BIT_US) | (duration > MAX_BIT_US));
+
+		// Most blocks in a frame contain only valid bits
+		if (any(breaks)) {
+			for (size_t lane = 0; lane < LANES; lane++) {
+				if (breaks[lane]) {
+					process(i + lane);
+				}
+			}
+		}
+	}
+
+	for (; i < count; i++) {
+		if (durations[i] < MIN_BIT_US || durations[i] > MAX_BIT_US) {
+			process(i);
+		}
+	}
+
+	// Frame without anything to end it
+	if (previousPause && count - previous - 1 >= MIN_FRAME_BITS) {
+		frames.push_back({ previous, count });
+	}
+}
+
+void PulseBatch::decode(const uint32_t *durations, size_t count, Replay &replay) {
+	std::vector<PulseFrame> frames;
+	size_t next = 0;
+	size_t context = 0;
+
+	findFrames(durations, count, frames);
+
+	for (const PulseFrame &frame : frames) {
+		// The pulse before the pause determines whether the pause was
+		// standalone or following another frame, unless it follows a run
+		// of bits from an earlier pause (which need to be processed again)
+		size_t start = frame.pause > 0 ? frame.pause - 1 : 0;
+
+		for (size_t j = frame.pause; j-- > context && j + MIN_FRAME_BITS + 1 > frame.pause; ) {
+			// Short pulses could be glitches in the earlier bits
+			if (durations[j] > MAX_BIT_US) {
+				if (durations[j] >= MIN_PAUSE_US) {
+					start = j;
+				}
+				break;
+			}
+		}
+
+		if (start < next) {
+			start = next;
+		}
+
+		for (size_t j = start; j <= frame.end && j < count; j++) {
+			// Once the receiver has given up on the frame, only a pause
+			// can start another code (without changing any other state)
+			if (j > frame.pause && durations[j] < MIN_PAUSE_US
+					&& !replay.receiver.isReceiving()) {
+				continue;
+			}
+
+			replay.edge(durations[j]);
+		}
+
+		next = frame.end + 1;
+		context = frame.end;
+	}
+
+	replay.flush();
+}
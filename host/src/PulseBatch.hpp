@@ -0,0 +1,58 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RF433_OOK_HOST_PULSEBATCH_HPP
+#define RF433_OOK_HOST_PULSEBATCH_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "Receiver.hpp"
+
+class Replay;
+
+// Range of pulses that could contain a code: the pause before it,
+// the bits (including the preamble) and the pulse that ends it
+struct PulseFrame {
+	size_t pause;
+	size_t end;
+};
+
+// Host only batch processing of captured pulse durations, using
+// vector operations to find the pulses that break up frames so that only
+// the candidate frames need to go through the interrupt handler (which
+// classifies the bits itself, using the bit times that it samples)
+class PulseBatch: private Receiver {
+public:
+	// Find ranges of pulses that start with a pause and are long enough
+	// to be a code before they reach a pulse that would abort the frame
+	static void findFrames(const uint32_t *durations, size_t count,
+			std::vector<PulseFrame> &frames);
+
+	// Process the candidate frames using the interrupt handler (noise
+	// between frames is not processed so the noise rate will be lower)
+	static void decode(const uint32_t *durations, size_t count, Replay &replay);
+
+private:
+	// Preamble bits and everything except the final bit
+	static constexpr size_t MIN_FRAME_BITS = 2 + Code::MIN_LENGTH - 1;
+};
+
+#endif
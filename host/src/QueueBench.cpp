@@ -0,0 +1,228 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <Host.hpp>
+
+#include "Capture.hpp"
+#include "Generator.hpp"
+#include "Queue.hpp"
+#include "Receiver.hpp"
+#include "Replay.hpp"
+
+static constexpr unsigned long SEQUENCE_LENGTH = 10000000;
+static constexpr unsigned int TRANSMISSIONS = 2000;
+static constexpr double GAP_US = 50000;
+
+// A valid code for each preset
+static const char *const CODES[] = {
+	"556565565A5A+5",
+	"566565565666+5",
+	"50154000041014404450551504011",
+	"41414114144444114444111114141441",
+};
+static constexpr unsigned int CODE_COUNT = sizeof(CODES) / sizeof(CODES[0]);
+
+// Transmissions of every preset with jitter, dropouts and noise, for when
+// there's no capture to use
+static std::vector<uint32_t> generate() {
+	Generator generator;
+	Impairments impairments;
+	double time = GAP_US;
+
+	impairments.jitter = 20;
+	impairments.dropout = 0.001;
+
+	for (unsigned int i = 0; i < TRANSMISSIONS; i++) {
+		const unsigned int p = i % CODE_COUNT;
+
+		time = generator.transmit(Code(CODES[p]), Transmitter::PRESETS[p], time, impairments) + GAP_US;
+	}
+
+	generator.noise(100, 20, 150);
+	return generator.durations();
+}
+
+// Two threads standing in for the RP2040 cores: one receives and decodes
+// (as on the second core) and the other outputs the codes (as on the first
+// core), which must be the same as the output from a single thread
+static bool pipeline(const std::vector<uint32_t> &durations) {
+	Replay reference;
+	Queue<Code, 16> queue;
+	// Overflow buffer for one long code at a time in the queue
+	uint8_t overflow[Code::OVERFLOW_SIZE];
+	std::atomic<bool> overflowUsed{false};
+	std::atomic<bool> finished{false};
+	host::StringPrint output;
+	std::vector<std::string> lines;
+	unsigned long stalls = 0;
+
+	reference.edges(durations.data(), durations.size());
+	reference.flush();
+	reference.receiver.detach();
+
+	auto start = std::chrono::steady_clock::now();
+
+	std::thread producer([&] {
+		Receiver receiver;
+
+		// Start at the same time as the single thread replay
+		host::setMicros(0);
+		receiver.attach(Replay::RX_PIN);
+
+		for (size_t i = 0; i < durations.size(); i++) {
+			host::edge(Replay::RX_PIN, durations[i]);
+
+			while (true) {
+				Code code;
+
+				// Wait for the output of a long code to finish with the buffer
+				while (overflowUsed) {
+					stalls++;
+					std::this_thread::yield();
+				}
+				code.setOverflow(overflow);
+
+				if (!receiver.decodeCode(code)) {
+					break;
+				}
+
+				overflowUsed = code.isLong();
+				while (!queue.push(code)) {
+					stalls++;
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		finished = true;
+	});
+
+	std::thread consumer([&] {
+		Code code;
+
+		while (true) {
+			bool done = finished;
+
+			if (queue.pop(code)) {
+				Receiver::printCode(&output, code);
+
+				if (code.isLong()) {
+					overflowUsed = false;
+				}
+			} else if (done) {
+				break;
+			} else {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	producer.join();
+	consumer.join();
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	size_t begin = 0;
+	size_t end;
+
+	while ((end = output.value.find("\r\n", begin)) != std::string::npos) {
+		lines.push_back(output.value.substr(begin, end - begin));
+		begin = end + 2;
+	}
+
+	printf("pipeline: %.1f Mpulse/s (%zu codes, %lu stalls)\n",
+		durations.size() / elapsed.count() / 1e6, lines.size(), stalls);
+
+	if (lines != reference.lines) {
+		fprintf(stderr, "pipeline output differs from single thread output\n");
+		return false;
+	}
+
+	return true;
+}
+
+// Check the ordering of a long sequence of values
+static bool sequence() {
+	Queue<unsigned long, 16> queue;
+	unsigned long errors = 0;
+
+	auto start = std::chrono::steady_clock::now();
+
+	std::thread producer([&] {
+		for (unsigned long i = 0; i < SEQUENCE_LENGTH; i++) {
+			while (!queue.push(i)) {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	std::thread consumer([&] {
+		unsigned long expected = 0;
+		unsigned long value;
+
+		while (expected < SEQUENCE_LENGTH) {
+			if (queue.pop(value)) {
+				if (value != expected) {
+					errors++;
+				}
+				expected = value + 1;
+			} else {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	producer.join();
+	consumer.join();
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	printf("sequence: %.1f Mitem/s (%lu out of order, %lu full)\n",
+		SEQUENCE_LENGTH / elapsed.count() / 1e6, errors, queue.droppedCount());
+	return errors == 0;
+}
+
+int main(int argc, char *argv[]) {
+	Capture capture;
+
+	if (argc > 2) {
+		fprintf(stderr, "Usage: %s [capture]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if (argc == 2) {
+		if (!capture.load(argv[1])) {
+			fprintf(stderr, "%s: unable to load capture\n", argv[1]);
+			return EXIT_FAILURE;
+		}
+	} else {
+		capture.durations = generate();
+	}
+
+	bool ok = sequence();
+	ok = pipeline(capture.durations) && ok;
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
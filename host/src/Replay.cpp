@@ -0,0 +1,103 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Host.hpp>
+
+#include "Replay.hpp"
+
+Replay::Replay() {
+	// Every replay starts at the same time so that the output is the same
+	host::setMicros(0);
+	receiver.attach(RX_PIN);
+}
+
+void Replay::edge(unsigned long duration) {
+	host::edge(RX_PIN, duration);
+	count++;
+
+	if (++pending >= FLUSH_INTERVAL) {
+		flush();
+	}
+}
+
+void Replay::edges(const uint32_t *durations, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		edge(durations[i]);
+	}
+}
+
+void Replay::flush() {
+	host::StringPrint output;
+
+	pending = 0;
+
+	do {
+		output.value.clear();
+		receiver.printCode(&output, burst);
+		addLines(output.value);
+	} while (!output.value.empty());
+
+	if (burst != nullptr) {
+		output.value.clear();
+		burst->expire(&output, micros());
+		addLines(output.value);
+	}
+}
+
+void Replay::finish() {
+	host::StringPrint output;
+
+	flush();
+
+	if (burst != nullptr) {
+		burst->flush(&output);
+		addLines(output.value);
+	}
+}
+
+void Replay::addLines(const std::string &output) {
+	size_t start = 0;
+	size_t end;
+
+	while ((end = output.find("\r\n", start)) != std::string::npos) {
+		lines.push_back(output.substr(start, end - start));
+		start = end + 2;
+	}
+}
+
+std::string Replay::code(const std::string &line) {
+	static const std::string prefix = "receive: {code: \"";
+
+	if (line.compare(0, prefix.length(), prefix) != 0) {
+		return "";
+	}
+
+	size_t end = line.find('"', prefix.length());
+	if (end == std::string::npos) {
+		return "";
+	}
+
+	return line.substr(prefix.length(), end - prefix.length());
+}
+
+bool Replay::validated(const std::string &line) {
+	static const std::string suffix = ",validated: true}";
+
+	return line.length() >= suffix.length()
+		&& line.compare(line.length() - suffix.length(), suffix.length(), suffix) == 0;
+}
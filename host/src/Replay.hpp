@@ -0,0 +1,65 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RF433_OOK_HOST_REPLAY_HPP
+#define RF433_OOK_HOST_REPLAY_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "Receiver.hpp"
+
+// Feeds pulse durations through the firmware interrupt handler
+// and collects the "receive:" lines that it outputs (and the "burst:"
+// lines of the combined repeats if there's a burst)
+class Replay {
+public:
+	static constexpr int RX_PIN = 2;
+
+	Replay();
+
+	void edge(unsigned long duration);
+	void edges(const uint32_t *durations, size_t count);
+	void flush();
+	// At the end of the input, output the current burst
+	void finish();
+
+	// Extract the code from a "receive:" line (empty if it isn't one)
+	static std::string code(const std::string &line);
+	// One of the decodes of a "receive:" line passed its checks
+	static bool validated(const std::string &line);
+
+	Receiver receiver;
+	Burst *burst = nullptr;
+	std::vector<std::string> lines;
+	unsigned long count = 0;
+
+private:
+	void addLines(const std::string &output);
+
+	// Codes take more than this many edges so there can only be
+	// one code in the receiver's buffer if it is checked this often
+	static constexpr unsigned int FLUSH_INTERVAL = 32;
+
+	unsigned int pending = 0;
+};
+
+#endif
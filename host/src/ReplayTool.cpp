@@ -0,0 +1,112 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <map>
+#include <string>
+
+#include "Capture.hpp"
+#include "Replay.hpp"
+
+// Replays captures through the receiver and outputs the codes,
+// with a summary of how they compare to the expected codes
+int main(int argc, char *argv[]) {
+	bool summaryOnly = false;
+	unsigned long pulses = 0;
+	unsigned long codes = 0;
+	unsigned long expected = 0;
+	unsigned long decoded = 0;
+	unsigned long falsePositives = 0;
+	unsigned long validated = 0;
+	unsigned long validatedFalsePositives = 0;
+	double elapsed = 0;
+	int i = 1;
+
+	if (i < argc && !strcmp(argv[i], "-s")) {
+		summaryOnly = true;
+		i++;
+	}
+
+	if (i >= argc) {
+		fprintf(stderr, "Usage: %s [-s] <capture>...\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	for (; i < argc; i++) {
+		Capture capture;
+		Replay replay;
+		Burst burst;
+		std::map<std::string, unsigned int> remaining;
+
+		if (!capture.load(argv[i])) {
+			fprintf(stderr, "%s: unable to load capture\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+
+		replay.burst = &burst;
+
+		auto start = std::chrono::steady_clock::now();
+		replay.edges(capture.durations.data(), capture.durations.size());
+		replay.finish();
+		elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		for (const Capture::Label &label : capture.expected) {
+			remaining[label.code] += label.count;
+			expected += label.count;
+		}
+
+		for (const std::string &line : replay.lines) {
+			const std::string code = Replay::code(line);
+
+			if (!summaryOnly) {
+				printf("%s\n", line.c_str());
+			}
+
+			if (code.empty()) {
+				continue;
+			}
+
+			codes++;
+
+			if (Replay::validated(line)) {
+				validated++;
+			}
+
+			auto it = remaining.find(code);
+			if (it == remaining.end()) {
+				falsePositives++;
+				if (Replay::validated(line)) {
+					validatedFalsePositives++;
+				}
+			} else if (it->second > 0) {
+				it->second--;
+				decoded++;
+			}
+		}
+
+		pulses += replay.count;
+	}
+
+	printf("summary: {pulses: %lu,codes: %lu,expected: %lu,decoded: %lu,falsePositives: %lu,validated: %lu,validatedFalsePositives: %lu,pulseCost: %.1f}\n",
+		pulses, codes, expected, decoded, falsePositives, validated, validatedFalsePositives, pulses ? elapsed * 1e9 / pulses : 0);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,181 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <Host.hpp>
+
+#include "Generator.hpp"
+#include "Replay.hpp"
+
+static constexpr unsigned int CODES = 200;
+static constexpr unsigned int MAX_VALUES = 32;
+static constexpr double GAP_US = 50000;
+
+static const char DIGITS[] = "0123456789ABCDEF";
+
+// A random code of whole values with an optional packed pair of trailing bits
+static std::string randomCode(std::mt19937 &rng) {
+	const unsigned int minValues = (Code::MIN_LENGTH + 3) / 4;
+	std::uniform_int_distribution<unsigned int> values(minValues, MAX_VALUES);
+	std::uniform_int_distribution<unsigned int> trailing(0, 4);
+	std::string code;
+
+	for (unsigned int i = values(rng); i > 0; i--) {
+		code += DIGITS[rng() & 0xF];
+	}
+
+	// The last pulse is low so that it ends in the pause after the code,
+	// which means codes can only have an even number of bits
+	const unsigned int packed = 0x3 + trailing(rng);
+	if (packed >= 0x4) {
+		code += '+';
+		code += DIGITS[packed];
+	}
+
+	return code;
+}
+
+// The code as it would be output by the receiver
+static std::string messageAsString(const Code &code) {
+	host::StringPrint output;
+
+	output.print("receive: ");
+	output.print(code);
+	return Replay::code(output.value);
+}
+
+// The receiver can't receive the final bit so it guesses it from the other bits
+class FinalBitCode: public Code {
+public:
+	FinalBitCode(const char *message) : Code(message) {}
+
+	// The code with the final bit replaced by the receiver's guess
+	std::string guessed() {
+		if (messageLength == 0) {
+			return "";
+		}
+
+		const uint8_t mask = 0x80 >> ((messageLength - 1) & 0x7);
+
+		messageLength--;
+		if (messageGuessFinalBit()) {
+			message[messageLength / 8] |= mask;
+		} else {
+			message[messageLength / 8] &= ~mask;
+		}
+		messageLength++;
+		return ::messageAsString(*this);
+	}
+};
+
+// Transmits random codes with each preset and checks that the codes
+// are parsed, transmitted, received and output without changes
+int main(int argc, char *argv[]) {
+	const unsigned long seed = argc > 1 ? strtoul(argv[1], nullptr, 10) : 433;
+	std::mt19937 rng(seed);
+	bool success = true;
+
+	for (unsigned int p = 0; p < Transmitter::PRESET_COUNT; p++) {
+		const Transmitter::Preset &preset = Transmitter::PRESETS[p];
+		std::vector<std::string> codes;
+		std::vector<std::string> guesses;
+		Generator generator(seed);
+		Replay replay;
+		// Silence before the first code, as there would be between codes
+		double time = GAP_US;
+		unsigned long parsed = 0;
+		unsigned long received = 0;
+		unsigned long finalBitGuessed = 0;
+		unsigned long failed = 0;
+		std::vector<unsigned int> receipts(CODES);
+		size_t next = 0;
+
+		for (unsigned int i = 0; i < CODES; i++) {
+			const std::string value = randomCode(rng);
+			const Code code(value.c_str());
+
+			if (messageAsString(code) == value) {
+				parsed++;
+			} else {
+				printf("differs: {preset: %u,code: \"%s\",parsed: \"%s\"}\n",
+					p, value.c_str(), messageAsString(code).c_str());
+				success = false;
+			}
+
+			codes.push_back(value);
+			guesses.push_back(FinalBitCode(value.c_str()).guessed());
+			time = generator.transmit(code, preset, time) + GAP_US;
+		}
+
+		const std::vector<uint32_t> durations = generator.durations();
+		replay.edges(durations.data(), durations.size());
+		replay.flush();
+
+		// Every repeat of a code is output, in order, with the
+		// final bit guessed exactly the way the firmware does
+		for (const std::string &line : replay.lines) {
+			const std::string value = Replay::code(line);
+			size_t i;
+
+			if (value.empty()) {
+				continue;
+			}
+
+			for (i = next; i < codes.size(); i++) {
+				if (guesses[i] == value) {
+					break;
+				}
+			}
+
+			if (i >= codes.size()) {
+				printf("differs: {preset: %u,received: \"%s\"}\n", p, value.c_str());
+				failed++;
+				continue;
+			}
+
+			if (codes[i] == value) {
+				received++;
+			} else {
+				finalBitGuessed++;
+			}
+			receipts[i]++;
+			next = i;
+		}
+
+		for (size_t i = 0; i < codes.size(); i++) {
+			if (receipts[i] != preset.repeat) {
+				printf("differs: {preset: %u,code: \"%s\",receipts: %u}\n", p, codes[i].c_str(), receipts[i]);
+				failed++;
+			}
+		}
+
+		printf("roundtrip: {preset: %u,codes: %u,parsed: %lu,expected: %u,received: %lu,finalBitGuessed: %lu,failed: %lu}\n",
+			p, CODES, parsed, CODES * preset.repeat, received, finalBitGuessed, failed);
+		if (failed) {
+			success = false;
+		}
+	}
+
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,452 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "LineScanner.hpp"
+#include "TransmitScheduler.hpp"
+
+static volatile sig_atomic_t stopping = 0;
+
+static void stop(int signum) {
+	(void)signum;
+	stopping = 1;
+}
+
+static int usage(const char *name) {
+	fprintf(stderr, "Usage: %s [options] <serial port> <socket>\n"
+		"  -b <bps>      serial port baud rate (default 115200)\n"
+		"  -d <percent>  transmit duty cycle limit (default 10)\n", name);
+	return EXIT_FAILURE;
+}
+
+static speed_t baudRate(unsigned long value) {
+	switch (value) {
+	case 9600: return B9600;
+	case 19200: return B19200;
+	case 38400: return B38400;
+	case 57600: return B57600;
+	case 115200: return B115200;
+	case 230400: return B230400;
+	case 460800: return B460800;
+	case 921600: return B921600;
+	default: return B0;
+	}
+}
+
+static uint64_t nowMillis() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static int openSerial(const char *path, speed_t speed) {
+	int fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+	struct termios tio;
+
+	if (fd < 0) {
+		perror(path);
+		return -1;
+	}
+
+	if (tcgetattr(fd, &tio)) {
+		perror(path);
+		close(fd);
+		return -1;
+	}
+
+	cfmakeraw(&tio);
+	cfsetispeed(&tio, speed);
+	cfsetospeed(&tio, speed);
+	tio.c_cflag |= CLOCAL | CREAD;
+
+	if (tcsetattr(fd, TCSANOW, &tio)) {
+		perror(path);
+		close(fd);
+		return -1;
+	}
+
+	tcflush(fd, TCIOFLUSH);
+	return fd;
+}
+
+static int listenSocket(const char *path) {
+	int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	struct sockaddr_un addr = {};
+
+	if (fd < 0) {
+		perror("socket");
+		return -1;
+	}
+
+	if (strlen(path) >= sizeof(addr.sun_path)) {
+		fprintf(stderr, "%s: path too long\n", path);
+		close(fd);
+		return -1;
+	}
+
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, path);
+	unlink(path);
+
+	if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) || listen(fd, SOMAXCONN)) {
+		perror(path);
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+// Owns the serial port so that clients can share the device: every line
+// of output is sent to every client (one line per packet) and requests
+// from clients (one or more lines per packet) are scheduled for the
+// transmitter
+class Server {
+public:
+	Server(int serial, int listener, unsigned int dutyCycle);
+	~Server();
+	bool run();
+
+	unsigned long requests = 0;
+	unsigned long rejected = 0;
+	unsigned long dropped = 0;
+	TransmitScheduler scheduler;
+
+private:
+	static constexpr int MAX_EVENTS = 16;
+
+	void watch(int fd, uint32_t events, int op);
+	bool readSerial();
+	bool writeSerial();
+	void sendNext();
+	void acceptClient();
+	void readClient(int fd);
+	void closeClient(int fd);
+	void broadcast(const LineScanner::Line &line);
+
+	int epoll;
+	int serial;
+	int listener;
+	LineScanner scanner;
+	std::string output; // Waiting to be written to the serial port
+	std::map<int, ModelTransmitter> clients;
+};
+
+Server::Server(int serial, int listener, unsigned int dutyCycle)
+		: scheduler(dutyCycle, nowMillis()), serial(serial), listener(listener) {
+	epoll = epoll_create1(EPOLL_CLOEXEC);
+	watch(serial, EPOLLIN, EPOLL_CTL_ADD);
+	watch(listener, EPOLLIN, EPOLL_CTL_ADD);
+}
+
+Server::~Server() {
+	for (const auto &client : clients) {
+		close(client.first);
+	}
+	close(epoll);
+}
+
+void Server::watch(int fd, uint32_t events, int op) {
+	struct epoll_event event = {};
+
+	event.events = events;
+	event.data.fd = fd;
+	epoll_ctl(epoll, op, fd, &event);
+}
+
+bool Server::run() {
+	struct epoll_event events[MAX_EVENTS];
+
+	while (!stopping) {
+		sendNext();
+
+		int count = epoll_wait(epoll, events, MAX_EVENTS, scheduler.timeout(nowMillis()));
+
+		if (count < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			perror("epoll_wait");
+			return false;
+		}
+
+		for (int i = 0; i < count; i++) {
+			const int fd = events[i].data.fd;
+
+			if (fd == serial) {
+				if ((events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) && !readSerial()) {
+					return false;
+				}
+				if ((events[i].events & EPOLLOUT) && !writeSerial()) {
+					return false;
+				}
+			} else if (fd == listener) {
+				acceptClient();
+			} else {
+				readClient(fd);
+			}
+		}
+	}
+
+	return true;
+}
+
+bool Server::readSerial() {
+	while (true) {
+		ssize_t length = read(serial, scanner.space(), scanner.spaceLength());
+
+		if (length < 0 && (errno == EAGAIN || errno == EINTR)) {
+			return true;
+		} else if (length <= 0) {
+			fprintf(stderr, "serial port closed\n");
+			return false;
+		}
+
+		scanner.added(length);
+
+		const uint64_t now = nowMillis();
+		LineScanner::Line line;
+
+		while (scanner.next(line)) {
+			if (line.startsWith("transmit: ")) {
+				scheduler.response(TransmitScheduler::Response::TRANSMIT, now);
+			} else if (line.startsWith("config: ")) {
+				scheduler.response(TransmitScheduler::Response::CONFIG, now);
+			} else if (line.startsWith("calibrate: ")) {
+				scheduler.response(TransmitScheduler::Response::CALIBRATE, now);
+			} else if (line.startsWith("stats: ")) {
+				scheduler.response(TransmitScheduler::Response::STATS, now);
+			}
+
+			if (line.length > 0) {
+				broadcast(line);
+			}
+		}
+	}
+}
+
+bool Server::writeSerial() {
+	while (!output.empty()) {
+		ssize_t length = write(serial, output.data(), output.length());
+
+		if (length < 0 && errno == EINTR) {
+			continue;
+		} else if (length < 0 && errno == EAGAIN) {
+			watch(serial, EPOLLIN | EPOLLOUT, EPOLL_CTL_MOD);
+			return true;
+		} else if (length < 0) {
+			perror("serial port");
+			return false;
+		}
+
+		output.erase(0, length);
+	}
+
+	watch(serial, EPOLLIN, EPOLL_CTL_MOD);
+	return true;
+}
+
+void Server::sendNext() {
+	if (output.empty() && scheduler.next(output, nowMillis())) {
+		writeSerial();
+	}
+}
+
+void Server::acceptClient() {
+	int fd;
+
+	while ((fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+		clients.emplace(std::piecewise_construct, std::forward_as_tuple(fd), std::forward_as_tuple());
+		watch(fd, EPOLLIN, EPOLL_CTL_ADD);
+	}
+}
+
+void Server::readClient(int fd) {
+	auto it = clients.find(fd);
+
+	// Closed earlier in the same batch of events
+	if (it == clients.end()) {
+		return;
+	}
+
+	ModelTransmitter &client = it->second;
+	char packet[LineScanner::SIZE];
+	ssize_t length;
+
+	// The length of the whole packet is returned even if it doesn't fit
+	while ((length = recv(fd, packet, sizeof(packet), MSG_TRUNC)) > 0) {
+		if ((size_t)length > sizeof(packet)) {
+			static const char *const reason = "error: {reason: \"invalid\"}";
+
+			requests++;
+			rejected++;
+			send(fd, reason, strlen(reason), MSG_DONTWAIT | MSG_NOSIGNAL);
+			continue;
+		}
+
+		const char *end = &packet[length];
+
+		for (const char *start = packet; start < end; ) {
+			const char *found = std::find(start, end, '\n');
+			size_t lineLength = found - start;
+
+			if (lineLength > 0 && start[lineLength - 1] == '\r') {
+				lineLength--;
+			}
+
+			if (lineLength > 0) {
+				const TransmitScheduler::Result result = scheduler.add(client, start, lineLength);
+				const char *reason = nullptr;
+
+				requests++;
+				if (result == TransmitScheduler::Result::FULL) {
+					reason = "error: {reason: \"full\"}";
+				} else if (result == TransmitScheduler::Result::INVALID) {
+					reason = "error: {reason: \"invalid\"}";
+				}
+
+				if (reason != nullptr) {
+					rejected++;
+					send(fd, reason, strlen(reason), MSG_DONTWAIT | MSG_NOSIGNAL);
+				}
+			}
+
+			start = found + 1;
+		}
+	}
+
+	if (length == 0 || (errno != EAGAIN && errno != EINTR)) {
+		closeClient(fd);
+	}
+}
+
+void Server::closeClient(int fd) {
+	clients.erase(fd);
+	close(fd);
+}
+
+void Server::broadcast(const LineScanner::Line &line) {
+	std::vector<int> closed;
+
+	for (const auto &client : clients) {
+		const int fd = client.first;
+
+		if (send(fd, line.data, line.length, MSG_DONTWAIT | MSG_NOSIGNAL) < 0) {
+			if (errno == EAGAIN) {
+				// The client isn't keeping up
+				dropped++;
+			} else {
+				closed.push_back(fd);
+			}
+		}
+	}
+
+	// Clients often send a request and then close the connection, so
+	// read anything they've sent before closing them
+	for (int fd : closed) {
+		readClient(fd);
+		if (clients.count(fd)) {
+			closeClient(fd);
+		}
+	}
+}
+
+// Shares a serial port connected to the device between clients
+// connected to a UNIX socket (SOCK_SEQPACKET)
+int main(int argc, char *argv[]) {
+	speed_t speed = B115200;
+	unsigned long dutyCycle = 10;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "b:d:")) != -1) {
+		switch (opt) {
+		case 'b':
+			speed = baudRate(strtoul(optarg, nullptr, 10));
+			if (speed == B0) {
+				fprintf(stderr, "%s: unsupported baud rate\n", optarg);
+				return EXIT_FAILURE;
+			}
+			break;
+
+		case 'd':
+			dutyCycle = strtoul(optarg, nullptr, 10);
+			if (dutyCycle < 1 || dutyCycle > 100) {
+				fprintf(stderr, "%s: duty cycle must be 1-100%%\n", optarg);
+				return EXIT_FAILURE;
+			}
+			break;
+
+		default:
+			return usage(argv[0]);
+		}
+	}
+
+	if (optind + 2 != argc) {
+		return usage(argv[0]);
+	}
+
+	const char *socketPath = argv[optind + 1];
+	int serial = openSerial(argv[optind], speed);
+	if (serial < 0) {
+		return EXIT_FAILURE;
+	}
+
+	int listener = listenSocket(socketPath);
+	if (listener < 0) {
+		close(serial);
+		return EXIT_FAILURE;
+	}
+
+	struct sigaction action = {};
+	action.sa_handler = stop;
+	sigaction(SIGINT, &action, nullptr);
+	sigaction(SIGTERM, &action, nullptr);
+
+	Server server(serial, listener, dutyCycle);
+	const bool ok = server.run();
+
+	printf("server: {requests: %lu,coalesced: %lu,rejected: %lu,timeouts: %lu,dropped: %lu,airtime: %.3f}\n",
+		server.requests, server.scheduler.coalesced, server.rejected,
+		server.scheduler.timeouts, server.dropped, server.scheduler.totalAirtime / 1e6);
+
+	unlink(socketPath);
+	close(listener);
+	close(serial);
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,261 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <simavr/avr_ioport.h>
+#include <simavr/sim_avr.h>
+#include <simavr/sim_cycle_timers.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_io.h>
+}
+
+#include "Capture.hpp"
+
+// Runs the AVR firmware (built with BENCH_CYCLES) under simavr with the
+// pulses from a capture on the receiver pin, counting the cycles taken by
+// each path through the interrupt handler
+//
+// The handler writes to GPIOR1 when it starts and the path it took to
+// GPIOR0 when it finishes (these have the same address on all AVRs)
+
+static constexpr avr_io_addr_t GPIOR0 = 0x3E;
+static constexpr avr_io_addr_t GPIOR1 = 0x4A;
+
+static constexpr uint32_t FREQUENCY = 16000000;
+// Wait for the firmware to start before the first pulse
+static constexpr uint32_t STARTUP_US = 100000;
+
+// In the same order as HandlerTiming in Receiver.cpp
+static const char *const PATHS[] = {
+	"other",
+	"pauseStandalone",
+	"pauseFollowing",
+	"zeroBit",
+	"oneBit",
+	"sampleZero",
+	"sampleOne",
+	"sampleSwap",
+	"sampleComplete",
+	"echo",
+	"noise",
+};
+static constexpr unsigned int PATH_COUNT = sizeof(PATHS) / sizeof(PATHS[0]);
+
+// Receiver pin (digital pin 2) for each board
+struct Board {
+	const char *mcu;
+	char port;
+	uint8_t bit;
+};
+
+static const Board BOARDS[] = {
+	{ "atmega328p", 'D', 2 }, // uno
+	{ "atmega32u4", 'D', 1 }, // micro
+	{ "atmega2560", 'E', 4 }, // mega2560
+};
+
+struct Stats {
+	unsigned long count = 0;
+	avr_cycle_count_t total = 0;
+	avr_cycle_count_t min = 0;
+	avr_cycle_count_t max = 0;
+
+	void add(avr_cycle_count_t cycles) {
+		if (count == 0 || cycles < min) {
+			min = cycles;
+		}
+		if (cycles > max) {
+			max = cycles;
+		}
+		total += cycles;
+		count++;
+	}
+};
+
+struct Bench {
+	avr_t *avr;
+	avr_irq_t *pin;
+	const std::vector<uint32_t> *durations;
+	size_t next = 0;
+	uint8_t level = 0;
+	bool finished = false;
+
+	avr_cycle_count_t edge = 0;
+	avr_cycle_count_t start = 0;
+	bool started = false;
+	Stats latency;
+	Stats paths[PATH_COUNT];
+};
+
+static avr_cycle_count_t edgeTimer(avr_t *avr, avr_cycle_count_t when, void *param) {
+	Bench *bench = (Bench *)param;
+
+	if (bench->next >= bench->durations->size()) {
+		bench->finished = true;
+		return 0;
+	}
+
+	// Each duration is the time until the next edge
+	bench->level = !bench->level;
+	bench->edge = avr->cycle;
+	avr_raise_irq(bench->pin, bench->level);
+
+	return when + avr_usec_to_cycles(avr, (*bench->durations)[bench->next++]);
+}
+
+static void startMarker(avr_t *avr, avr_io_addr_t addr, uint8_t value, void *param) {
+	Bench *bench = (Bench *)param;
+
+	avr->data[addr] = value;
+	bench->start = avr->cycle;
+	bench->started = true;
+	bench->latency.add(avr->cycle - bench->edge);
+}
+
+static void endMarker(avr_t *avr, avr_io_addr_t addr, uint8_t value, void *param) {
+	Bench *bench = (Bench *)param;
+
+	avr->data[addr] = value;
+	if (bench->started && value < PATH_COUNT) {
+		bench->paths[value].add(avr->cycle - bench->start);
+	}
+	bench->started = false;
+}
+
+static void print(const char *name, const Stats &stats) {
+	if (stats.count) {
+		printf("cycles: {path: \"%s\",count: %lu,min: %llu,mean: %llu,max: %llu}\n",
+			name, stats.count, (unsigned long long)stats.min,
+			(unsigned long long)(stats.total / stats.count),
+			(unsigned long long)stats.max);
+	}
+}
+
+static int usage(const char *name) {
+	fprintf(stderr, "Usage: %s [-m <mcu>] [-w <max cycles>] <firmware.elf> <capture>\n", name);
+	return EXIT_FAILURE;
+}
+
+int main(int argc, char *argv[]) {
+	const char *mcu = "atmega328p";
+	unsigned long limit = 0;
+	const Board *board = nullptr;
+	elf_firmware_t firmware;
+	Capture capture;
+	Bench bench;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "m:w:")) != -1) {
+		switch (opt) {
+		case 'm':
+			mcu = optarg;
+			break;
+
+		case 'w':
+			limit = strtoul(optarg, nullptr, 10);
+			break;
+
+		default:
+			return usage(argv[0]);
+		}
+	}
+
+	if (optind + 2 != argc) {
+		return usage(argv[0]);
+	}
+
+	for (const Board &candidate : BOARDS) {
+		if (!strcmp(candidate.mcu, mcu)) {
+			board = &candidate;
+		}
+	}
+
+	if (board == nullptr) {
+		fprintf(stderr, "%s: unsupported mcu\n", mcu);
+		return EXIT_FAILURE;
+	}
+
+	memset(&firmware, 0, sizeof(firmware));
+	if (elf_read_firmware(argv[optind], &firmware)) {
+		fprintf(stderr, "%s: unable to load firmware\n", argv[optind]);
+		return EXIT_FAILURE;
+	}
+
+	if (!capture.load(argv[optind + 1])) {
+		fprintf(stderr, "%s: unable to load capture\n", argv[optind + 1]);
+		return EXIT_FAILURE;
+	}
+
+	strncpy(firmware.mmcu, board->mcu, sizeof(firmware.mmcu) - 1);
+	firmware.frequency = FREQUENCY;
+
+	bench.avr = avr_make_mcu_by_name(firmware.mmcu);
+	if (bench.avr == nullptr) {
+		fprintf(stderr, "%s: unsupported by simavr\n", firmware.mmcu);
+		return EXIT_FAILURE;
+	}
+
+	avr_init(bench.avr);
+	avr_load_firmware(bench.avr, &firmware);
+
+	bench.pin = avr_io_getirq(bench.avr, AVR_IOCTL_IOPORT_GETIRQ(board->port), board->bit);
+	bench.durations = &capture.durations;
+
+	avr_register_io_write(bench.avr, GPIOR1, startMarker, &bench);
+	avr_register_io_write(bench.avr, GPIOR0, endMarker, &bench);
+	avr_cycle_timer_register_usec(bench.avr, STARTUP_US, edgeTimer, &bench);
+
+	while (!bench.finished) {
+		int state = avr_run(bench.avr);
+
+		if (state == cpu_Done || state == cpu_Crashed) {
+			fprintf(stderr, "firmware stopped running\n");
+			return EXIT_FAILURE;
+		}
+	}
+
+	avr_cycle_count_t worst = 0;
+	unsigned int worstPath = 0;
+
+	print("latency", bench.latency);
+	for (unsigned int i = 0; i < PATH_COUNT; i++) {
+		print(PATHS[i], bench.paths[i]);
+
+		if (bench.paths[i].max > worst) {
+			worst = bench.paths[i].max;
+			worstPath = i;
+		}
+	}
+
+	printf("worst: {path: \"%s\",cycles: %llu}\n", PATHS[worstPath], (unsigned long long)worst);
+
+	if (limit && worst > limit) {
+		fprintf(stderr, "worst case of %llu cycles is more than %lu\n", (unsigned long long)worst, limit);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
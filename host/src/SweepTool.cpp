@@ -0,0 +1,89 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <string>
+
+#include "Generator.hpp"
+#include "Replay.hpp"
+
+static constexpr unsigned int TRANSMISSIONS = 100;
+static constexpr double GAP_US = 100000;
+
+static const char *const CODE = "556565565A5A+5";
+static constexpr unsigned int PRESET = 1;
+
+// Noise pulses per second
+static const double NOISE_RATES[] = { 0, 100, 200, 500, 1000, 2000, 5000, 10000, 20000 };
+// Jitter (µs) at each noise rate
+static const double JITTERS[] = { 0, 25, 50, 100 };
+
+// Generates transmissions of a code with increasing amounts of noise and
+// jitter, reporting the proportion of codes that are received and the
+// cost of processing the pulses
+int main() {
+	const Transmitter::Preset &preset = Transmitter::PRESETS[PRESET];
+	const Code code(CODE);
+
+	for (double jitter : JITTERS) {
+		for (double noiseRate : NOISE_RATES) {
+			Generator generator;
+			Impairments impairments;
+			Replay replay;
+			double time = 0;
+			unsigned long decoded = 0;
+			unsigned long falsePositives = 0;
+			const unsigned long expected = TRANSMISSIONS * preset.repeat;
+
+			impairments.jitter = jitter;
+
+			for (unsigned int i = 0; i < TRANSMISSIONS; i++) {
+				time = generator.transmit(code, preset, time, impairments) + GAP_US;
+			}
+			generator.noise(noiseRate, 20, 150);
+
+			const std::vector<uint32_t> durations = generator.durations();
+
+			auto start = std::chrono::steady_clock::now();
+			replay.edges(durations.data(), durations.size());
+			replay.flush();
+			std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+			for (const std::string &line : replay.lines) {
+				const std::string received = Replay::code(line);
+
+				if (received.empty()) {
+					continue;
+				} else if (received == CODE) {
+					decoded++;
+				} else {
+					falsePositives++;
+				}
+			}
+
+			printf("sweep: {jitter: %.0f,noiseRate: %.0f,expected: %lu,decoded: %lu,falsePositives: %lu,pulseCost: %.1f}\n",
+				jitter, noiseRate, expected, decoded, falsePositives,
+				elapsed.count() * 1e9 / durations.size());
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
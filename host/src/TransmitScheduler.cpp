@@ -0,0 +1,316 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Host.hpp>
+
+#include "TransmitScheduler.hpp"
+
+bool ModelTransmitter::Config::operator==(const Config &other) const {
+	return prePauseTime == other.prePauseTime
+		&& interPauseTime == other.interPauseTime
+		&& postPauseTime == other.postPauseTime
+		&& preambleTime[0] == other.preambleTime[0]
+		&& preambleTime[1] == other.preambleTime[1]
+		&& bitTime[0] == other.bitTime[0]
+		&& bitTime[1] == other.bitTime[1]
+		&& repeat == other.repeat;
+}
+
+std::string ModelTransmitter::Config::line() const {
+	char buffer[MAX_LENGTH + 1];
+
+	snprintf(buffer, sizeof(buffer), "B=%u,I=%u,A=%u,H=%u,L=%u,0=%u,1=%u,R=%u",
+		prePauseTime, interPauseTime, postPauseTime, preambleTime[0],
+		preambleTime[1], bitTime[0], bitTime[1], repeat);
+	return buffer;
+}
+
+bool ModelTransmitter::process(const std::string &token) {
+	host::StringStream input(token + "\n");
+
+	transmitted = false;
+	processInput(&input);
+	return transmitted;
+}
+
+ModelTransmitter::Config ModelTransmitter::config() const {
+	return {
+		prePauseTime, interPauseTime, postPauseTime,
+		{ preambleTime[0], preambleTime[1] },
+		{ bitTime[0], bitTime[1] },
+		repeat,
+	};
+}
+
+void ModelTransmitter::configure(const Config &config) {
+	prePauseTime = config.prePauseTime;
+	interPauseTime = config.interPauseTime;
+	postPauseTime = config.postPauseTime;
+	preambleTime[0] = config.preambleTime[0];
+	preambleTime[1] = config.preambleTime[1];
+	bitTime[0] = config.bitTime[0];
+	bitTime[1] = config.bitTime[1];
+	repeat = config.repeat;
+}
+
+void ModelTransmitter::transmit(const Code &code) {
+	(void)code;
+	transmitted = true;
+}
+
+TransmitScheduler::TransmitScheduler(unsigned int dutyCycle, uint64_t now)
+		: refilled(now), dutyCycle(dutyCycle) {
+	capacity = WINDOW_MS * 1000 * dutyCycle / 100;
+	allowance = capacity;
+}
+
+TransmitScheduler::Result TransmitScheduler::add(ModelTransmitter &client,
+		const char *data, size_t length) {
+	Result result = Result::QUEUED;
+	unsigned int priority = DEFAULT_PRIORITY;
+
+	if (!parse(data, length)) {
+		return Result::INVALID;
+	}
+
+	for (size_t start = 0, end; start < length; start = end + 1) {
+		const char *found = (const char *)memchr(&data[start], ',', length - start);
+		const std::string token(&data[start], found ? found - &data[start] : length - start);
+		Result tokenResult = Result::QUEUED;
+
+		end = found ? found - data : length;
+
+		if (token.empty()) {
+			continue;
+		} else if (token.compare(0, 2, "Q=") == 0) {
+			char *endptr = nullptr;
+			unsigned long value = strtoul(&token[2], &endptr, 10);
+
+			if (token.length() > 2 && !*endptr && value < PRIORITIES) {
+				priority = value;
+			}
+		} else if (token[0] == '~' || token[0] == '!' || token[0] == '?'
+				|| token.compare(0, 2, "E=") == 0) {
+			tokenResult = addCommand(token, priority);
+		} else if (client.process(token)) {
+			tokenResult = addCode(client, token, priority);
+		}
+
+		if (tokenResult != Result::QUEUED) {
+			result = tokenResult;
+		}
+	}
+
+	return result;
+}
+
+// Check that the request fits in the transmitter's buffer
+bool TransmitScheduler::parse(const char *data, size_t length) {
+	if (length == 0 || length > ModelTransmitter::MAX_LENGTH) {
+		return false;
+	}
+
+	for (size_t i = 0; i < length; i++) {
+		if (data[i] < ' ' || data[i] > '~') {
+			return false;
+		}
+	}
+	return true;
+}
+
+TransmitScheduler::Result TransmitScheduler::addCode(ModelTransmitter &client,
+		const std::string &token, unsigned int priority) {
+	uint8_t overflow[Code::OVERFLOW_SIZE];
+	const Request request = {
+		token, false, Response::TRANSMIT,
+		client.config(), client.airtime(Code(token.c_str(), overflow)),
+	};
+
+	// It would never be sent
+	if (request.airtime > capacity - reserve(priority)) {
+		return Result::INVALID;
+	}
+
+	for (unsigned int i = 0; i < PRIORITIES; i++) {
+		for (auto it = pending[i].begin(); it != pending[i].end(); ++it) {
+			if (!it->command && it->line == request.line && it->config == request.config) {
+				coalesced++;
+
+				// Move it to the more urgent priority
+				if (priority < i) {
+					pending[i].erase(it);
+					pending[priority].push_back(request);
+				}
+				return Result::QUEUED;
+			}
+		}
+	}
+
+	if (size() >= MAX_REQUESTS) {
+		return Result::FULL;
+	}
+
+	pending[priority].push_back(request);
+	return Result::QUEUED;
+}
+
+TransmitScheduler::Result TransmitScheduler::addCommand(const std::string &token,
+		unsigned int priority) {
+	Request request = { token, true, Response::CONFIG, device.config(), 0 };
+
+	if (token[0] == '~') {
+		request.response = Response::CALIBRATE;
+	} else if (token[0] == '!') {
+		request.response = Response::STATS;
+	}
+
+	if (size() >= MAX_REQUESTS) {
+		return Result::FULL;
+	}
+
+	pending[priority].push_back(request);
+	return Result::QUEUED;
+}
+
+size_t TransmitScheduler::size() const {
+	size_t total = 0;
+
+	for (const std::deque<Request> &requests : pending) {
+		total += requests.size();
+	}
+	return total;
+}
+
+const TransmitScheduler::Request *TransmitScheduler::head(unsigned int &priority) const {
+	for (priority = 0; priority < PRIORITIES; priority++) {
+		if (!pending[priority].empty()) {
+			return &pending[priority].front();
+		}
+	}
+	return nullptr;
+}
+
+unsigned long TransmitScheduler::airtime(const Request &request) const {
+	if (!request.command) {
+		return request.airtime;
+	} else if (request.response == Response::CALIBRATE) {
+		return 2 * device.airtime(Code(ModelTransmitter::CALIBRATION_CODE));
+	} else {
+		return 0;
+	}
+}
+
+// Allowance (µs) that less urgent requests can't use
+uint64_t TransmitScheduler::reserve(unsigned int priority) const {
+	return capacity * priority / 4;
+}
+
+uint64_t TransmitScheduler::available(uint64_t now) const {
+	const uint64_t value = allowance + (now - refilled) * 1000 * dutyCycle / 100;
+
+	return value < capacity ? value : capacity;
+}
+
+bool TransmitScheduler::next(std::string &request, uint64_t now) {
+	unsigned int priority;
+
+	if (waiting && now >= deadline()) {
+		waiting = false;
+		timeouts++;
+	}
+
+	const Request *first = head(priority);
+
+	if (waiting || now < busyUntil || first == nullptr) {
+		return false;
+	}
+
+	const unsigned long required = airtime(*first);
+
+	allowance = available(now);
+	refilled = now;
+
+	if (allowance < required + reserve(priority)) {
+		return false;
+	}
+
+	if (!first->command && (!configured || !(device.config() == first->config))) {
+		// Configure the device before transmitting
+		request = first->config.line();
+		expected = Response::CONFIG;
+		onAir = 0;
+		device.configure(first->config);
+		configured = true;
+	} else {
+		request = first->line;
+		expected = first->response;
+		// Calibration responds after transmitting
+		onAir = expected == Response::TRANSMIT ? required : 0;
+		allowance -= required;
+		totalAirtime += required;
+		pending[priority].pop_front();
+	}
+
+	request += '\n';
+	waiting = true;
+	sent = now;
+	return true;
+}
+
+void TransmitScheduler::response(Response type, uint64_t now) {
+	if (waiting && type == expected) {
+		waiting = false;
+		busyUntil = now + (onAir + 999) / 1000;
+	}
+}
+
+// Time (ms) that the response to the current request is expected by,
+// allowing for its airtime if the device doesn't respond
+uint64_t TransmitScheduler::deadline() const {
+	return sent + TIMEOUT_MS + (onAir + 999) / 1000;
+}
+
+int TransmitScheduler::timeout(uint64_t now) const {
+	unsigned int priority;
+
+	if (waiting) {
+		return now >= deadline() ? 0 : deadline() - now;
+	}
+
+	const Request *first = head(priority);
+
+	if (first == nullptr) {
+		return -1;
+	} else if (now < busyUntil) {
+		return busyUntil - now;
+	}
+
+	const uint64_t required = airtime(*first) + reserve(priority);
+	const uint64_t value = available(now);
+
+	if (value >= required) {
+		return 0;
+	}
+
+	// Round up to the next ms
+	return ((required - value) * 100 + dutyCycle * 1000 - 1) / (dutyCycle * 1000);
+}
@@ -0,0 +1,164 @@
+/*
+ * rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+ * Copyright 2026  Simon Arlott
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RF433_OOK_HOST_TRANSMIT_SCHEDULER_HPP
+#define RF433_OOK_HOST_TRANSMIT_SCHEDULER_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <string>
+
+#include "Transmitter.hpp"
+
+// The transmitter configuration of a client's requests (each client has
+// its own, as if it had its own transmitter), which processes them in
+// the same way without transmitting
+class ModelTransmitter: public Transmitter {
+public:
+	struct Config {
+		unsigned int prePauseTime;
+		unsigned int interPauseTime;
+		unsigned int postPauseTime;
+		unsigned int preambleTime[2];
+		unsigned int bitTime[2];
+		unsigned int repeat;
+
+		bool operator==(const Config &other) const;
+		// Input for the transmitter that sets this configuration
+		std::string line() const;
+	};
+
+	ModelTransmitter() : Transmitter(-1, true) {}
+
+	// Process part of a request (returns true if it's a code that would
+	// have been transmitted)
+	bool process(const std::string &token);
+
+	Config config() const;
+	void configure(const Config &config);
+
+	using Transmitter::CALIBRATION_CODE;
+	using Transmitter::MAX_LENGTH;
+
+protected:
+	virtual void transmit(const Code &code) override;
+
+private:
+	bool transmitted = false;
+};
+
+// Requests from clients for the transmitter, which are sent to the device
+// one at a time because the device doesn't read its input while it's
+// transmitting. The next request is sent when the device outputs the
+// response to the current request (or it times out, if the device is
+// silent or the request is invalid). The transmit response is output
+// before the code is transmitted, so the next request is also held
+// until the airtime of the code has passed.
+//
+// Codes are transmitted in order of priority ("Q=0" urgent, "Q=1" normal
+// and "Q=2" bulk for the rest of a request) with the configuration that
+// was current in the client's requests, which is sent to the device
+// first if it's different. A code that's the same as one that's still
+// waiting, with the same configuration, is only transmitted once.
+//
+// The airtime of each transmission is accounted for so that the device
+// stays within a duty cycle limit over an hour, with some of the allowance
+// reserved for more urgent requests. Any other commands are sent in order
+// of priority (calibration has the airtime of two transmissions).
+class TransmitScheduler {
+public:
+	enum class Result : uint8_t {
+		QUEUED,
+		COALESCED,
+		FULL,
+		INVALID,
+	};
+
+	// Response that the device outputs for each type of request
+	enum class Response : uint8_t {
+		CONFIG,
+		TRANSMIT,
+		CALIBRATE,
+		STATS,
+	};
+
+	// Duty cycle limit (%)
+	TransmitScheduler(unsigned int dutyCycle, uint64_t now);
+
+	// Add a line of requests from a client
+	Result add(ModelTransmitter &client, const char *data, size_t length);
+
+	// Get the next request to send (with a line ending) if the device is
+	// ready for it, the current time is in ms
+	bool next(std::string &request, uint64_t now);
+	// The device has output a response, the current time is in ms
+	void response(Response type, uint64_t now);
+	// Time (ms) until the current request times out or there's enough
+	// airtime for the next request, or -1 if there's nothing to wait for
+	int timeout(uint64_t now) const;
+
+	static constexpr unsigned int PRIORITIES = 3;
+	static constexpr unsigned int DEFAULT_PRIORITY = 1;
+	static constexpr size_t MAX_REQUESTS = 64;
+	static constexpr unsigned int TIMEOUT_MS = 1000;
+	static constexpr uint64_t WINDOW_MS = 3600000;
+
+	unsigned long coalesced = 0;
+	unsigned long timeouts = 0;
+	uint64_t totalAirtime = 0; // µs
+
+private:
+	struct Request {
+		std::string line; // Code or command
+		bool command;
+		Response response;
+		ModelTransmitter::Config config;
+		unsigned long airtime; // µs
+	};
+
+	static bool parse(const char *data, size_t length);
+	Result addCode(ModelTransmitter &client, const std::string &token, unsigned int priority);
+	Result addCommand(const std::string &token, unsigned int priority);
+	size_t size() const;
+	const Request *head(unsigned int &priority) const;
+	unsigned long airtime(const Request &request) const;
+	uint64_t deadline() const;
+	uint64_t reserve(unsigned int priority) const;
+	uint64_t available(uint64_t now) const;
+
+	std::deque<Request> pending[PRIORITIES];
+	ModelTransmitter device; // Configuration of the device
+	bool configured = false; // The device configuration is known
+
+	bool waiting = false;
+	Response expected;
+	uint64_t sent = 0;
+	unsigned long onAir = 0; // Airtime (µs) of the current request
+	uint64_t busyUntil = 0; // The device is transmitting
+
+	// Airtime (µs) that can be used now, which increases at the duty
+	// cycle rate up to the limit for the window
+	uint64_t allowance;
+	uint64_t capacity;
+	uint64_t refilled;
+	unsigned int dutyCycle;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+#
+# rf433-ook - Arduino 433MHz OOK Receiver/Transmitter
+# Copyright 2026  Simon Arlott
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import argparse
+import concurrent.futures
+import itertools
+import os
+import re
+import subprocess
+import sys
+
+PARAMETERS = [
+	"MIN_RELATIVE_DURATION",
+	"MIN_ZERO_DURATION",
+	"MAX_ZERO_DURATION",
+	"MIN_ONE_DURATION",
+	"MAX_ONE_DURATION",
+	"PREAMBLE_RELATIVE_DURATION",
+	"MIN_SAMPLES",
+	"MAX_SAMPLES",
+	"MIN_PAUSE_US",
+]
+
+SUMMARY = re.compile(r"^summary: \{pulses: (\d+),codes: (\d+),expected: (\d+),decoded: (\d+),falsePositives: (\d+),validated: (\d+),validatedFalsePositives: (\d+),pulseCost: ([0-9.]+)\}$", re.M)
+
+def parameter(value):
+	name, _, values = value.partition("=")
+	if name not in PARAMETERS or not values:
+		raise argparse.ArgumentTypeError("expected NAME=VALUE[,VALUE...] where NAME is one of " + ", ".join(PARAMETERS))
+	return (name, [int(x) for x in values.split(",")])
+
+def run(directory, index, values, captures):
+	build = os.path.join("build", "sweep", str(index))
+	defines = " ".join(["-DRECEIVER_{0}={1}".format(name, value) for (name, value) in values])
+	subprocess.run(["make", "-s", "BUILD=" + build, "CPPFLAGS=" + defines, build + "/rf433-replay"],
+		cwd=directory, check=True, stdout=subprocess.DEVNULL)
+	output = subprocess.run([os.path.join(directory, build, "rf433-replay"), "-s"] + captures,
+		check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+	match = SUMMARY.search(output)
+	return {
+		"pulses": int(match.group(1)),
+		"codes": int(match.group(2)),
+		"expected": int(match.group(3)),
+		"decoded": int(match.group(4)),
+		"falsePositives": int(match.group(5)),
+		"validated": int(match.group(6)),
+		"validatedFalsePositives": int(match.group(7)),
+		"pulseCost": float(match.group(8)),
+	}
+
+if __name__ == "__main__":
+	parser = argparse.ArgumentParser(description="Receiver timing parameter sweep")
+	parser.add_argument("-j", "--jobs", metavar="JOBS", type=int, default=os.cpu_count(), help="number of parallel builds/replays")
+	parser.add_argument("-p", "--parameter", metavar="NAME=VALUES", type=parameter, action="append", default=[], help="comma separated values to try for a parameter")
+	parser.add_argument("captures", metavar="CAPTURE", type=str, nargs="+", help="labelled capture file")
+	args = parser.parse_args()
+
+	directory = os.path.dirname(os.path.abspath(__file__))
+	captures = [os.path.abspath(x) for x in args.captures]
+	names = [name for (name, _) in args.parameter]
+	grid = [list(zip(names, values)) for values in itertools.product(*[values for (_, values) in args.parameter])]
+
+	with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as executor:
+		results = list(executor.map(lambda job: run(directory, job[0], job[1], captures), enumerate(grid)))
+
+	# Best decode rate first, then fewest false positives, then lowest cost
+	ranked = sorted(zip(grid, results), key=lambda x: (-x[1]["decoded"], x[1]["falsePositives"], x[1]["pulseCost"]))
+
+	for (values, result) in ranked:
+		rate = result["decoded"] / result["expected"] if result["expected"] else 0
+		print("{{{0}decodeRate: {1:.3f},falsePositives: {2},validated: {3},validatedFalsePositives: {4},pulseCost: {5:.1f}}}".format(
+			"".join(["{0}: {1},".format(name, value) for (name, value) in values]),
+			rate, result["falsePositives"], result["validated"], result["validatedFalsePositives"], result["pulseCost"]))
+
+	sys.exit(0)